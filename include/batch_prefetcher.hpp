@@ -0,0 +1,75 @@
+#ifndef BATCH_PREFETCHER_HPP
+#define BATCH_PREFETCHER_HPP
+
+#include "datatypes/tensor.hpp"
+
+/**
+ * @brief The BatchPrefetcher class assembles the next batches on a background thread while the current batch trains.
+ * The batches are handed over through a single-producer single-consumer ring without locks, the threads only block
+ * (std::atomic::wait) when the ring is full or empty. The tensors of a slot are reused for a later batch as soon as
+ * nobody else holds them, so the steady state allocates no memory.
+ */
+class BatchPrefetcher
+{
+public:
+    /**
+     * @brief copies the batch that starts at a position of the shuffled training set into the tensors, reusing them if possible
+     */
+    typedef std::function<void(std::uint32_t first, std::shared_ptr<Tensor> &data, std::shared_ptr<Tensor> &labels)> Gather;
+
+private:
+    struct Slot
+    {
+        std::shared_ptr<Tensor> pData;
+        std::shared_ptr<Tensor> pLabels;
+    };
+
+    std::vector<Slot> mSlots;              // depth + 1 slots, the extra one belongs to the batch that is training
+    std::uint32_t mDepth;                  // the number of batches assembled ahead
+    std::atomic<std::uint64_t> mProduced = 0;
+    std::atomic<std::uint64_t> mConsumed = 0;
+    std::atomic<bool> mStop = false;
+    std::exception_ptr mpError = nullptr;  // the exception of the producer, rethrown by take
+    std::thread mThread;
+
+    std::uint32_t mNext = 0;      // the position of the next batch take returns
+    std::uint32_t mBatchSize = 0;
+    bool mRunning = false;
+
+    /**
+     * @brief the loop of the producer thread
+     */
+    void mProduce(const Gather &gather, std::uint32_t first, std::uint32_t end);
+
+public:
+    /**
+     * @param depth the number of batches assembled ahead, 2 for double buffering
+     */
+    explicit BatchPrefetcher(std::uint32_t depth);
+    ~BatchPrefetcher();
+
+    BatchPrefetcher(const BatchPrefetcher &) = delete;
+    BatchPrefetcher &operator=(const BatchPrefetcher &) = delete;
+
+    /**
+     * @brief start assembling the batches at first, first + batchSize, ... that end before end
+     */
+    void start(const Gather &gather, std::uint32_t first, std::uint32_t batchSize, std::uint32_t end);
+
+    /**
+     * @brief stop the producer, e.g. before the order of the training set changes
+     */
+    void stop();
+
+    /**
+     * @brief check whether the next batch take returns starts at first and has the given size
+     */
+    [[nodiscard]] bool ready(std::uint32_t first, std::uint32_t batchSize) const;
+
+    /**
+     * @brief wait for the next batch
+     */
+    void take(std::shared_ptr<Tensor> &data, std::shared_ptr<Tensor> &labels);
+};
+
+#endif // BATCH_PREFETCHER_HPP
@@ -7,6 +7,7 @@
 
 
 #include "reader.hpp"
+#include "dataset_cache.hpp"
 #include "optimizer/optimizer.hpp"
 #include "preprocessing/preprocessing.hpp"
 #include "model.hpp"
@@ -0,0 +1,16 @@
+#ifndef CONFIG_HPP
+#define CONFIG_HPP
+
+/**
+ * @brief Compile time configuration of brainet.
+ * Precision is the element type of all tensors used in the graph. It defaults to float and can be switched to double
+ * by defining BRAINET_DOUBLE_PRECISION (cmake option of the same name).
+ * Tensors with other element types (e.g. the 16 bit storage types) can still be created per tensor with BasicTensor.
+ */
+#ifdef BRAINET_DOUBLE_PRECISION
+typedef double Precision;
+#else
+typedef float Precision;
+#endif
+
+#endif // CONFIG_HPP
@@ -0,0 +1,83 @@
+#ifndef DATA_PARALLEL_HPP
+#define DATA_PARALLEL_HPP
+
+#include "graph_replica.hpp"
+#include "parallel.hpp"
+
+/**
+ * @brief The DataParallel class trains a model synchronously on several replicas of its graph. Every replica has its own
+ * copies of the operations and variables and reads the parameters of the model, each one runs on its own member of a
+ * ThreadTeam with its own group of cores. A batch is split into contiguous shards of rows, one per replica.
+ * The gradients are all-reduced while the backward pass is still running: every parameter variable is a bucket, the replicas
+ * compute the buckets from the loss backwards and the replica that finishes a bucket last sums it over all replicas,
+ * while the others continue with the next bucket. The sum is a pairwise tree in replica order, so it does not depend on
+ * which thread computes it. The model takes a single optimizer step with the summed gradients.
+ */
+class DataParallel
+{
+    typedef std::shared_ptr<Variable> VariablePtr;
+
+    std::uint32_t mReplicaCount;
+    std::uint32_t mCoresPerReplica;
+    ThreadTeam mTeam;
+    std::vector<GraphReplica> mReplicas;
+    std::vector<VariablePtr> mModelLearnables; // the learnable variables the replicas were built for
+
+    double mComputeSeconds = 0; // time all replicas spent on forward and backward passes
+    double mReduceSeconds = 0;  // time all replicas spent summing gradients
+    double mWallSeconds = 0;    // time the steps took
+    std::uint64_t mExamples = 0;
+
+    /**
+     * @brief sum the gradients of all replicas into the first one as a pairwise tree
+     */
+    static void mReduce(std::vector<std::shared_ptr<Tensor>> &parts);
+
+    /**
+     * @brief copy rows [begin, end) of a batch
+     */
+    static std::shared_ptr<Tensor> mSlice(Tensor &batch, std::uint64_t begin, std::uint64_t end);
+
+public:
+    /**
+     * @brief create the threads of the replicas
+     * @param replicas the number of replicas, every replica gets an equal share of the cores
+     */
+    explicit DataParallel(std::uint32_t replicas);
+
+    /**
+     * @brief forward and backward pass of the loaded batch on all replicas, afterwards the gradient table of the graph holds
+     * the gradients of the whole batch and the loss variables hold the loss of the batch
+     * @param graphInputs the data and label variable of the dataset followed by the learnable variables
+     * @param learnableVariables the variables the gradients are computed for, their weights must exist
+     * @param gradientVariables the variables the backward pass starts from
+     * @param lossVariables the loss and surrogate loss variables
+     * @param leafInitValue the initial gradient of the gradient variables for the whole batch
+     */
+    void step(std::vector<VariablePtr> &graphInputs, const std::vector<VariablePtr> &learnableVariables, const std::vector<VariablePtr> &gradientVariables, const std::vector<VariablePtr> &lossVariables, double leafInitValue);
+
+    [[nodiscard]] std::uint32_t replicaCount() const;
+
+    /**
+     * @brief get the number of training examples processed per second since the last reset
+     */
+    [[nodiscard]] double examplesPerSecond() const;
+
+    /**
+     * @brief get the share of the replica time spent on forward and backward passes since the last reset,
+     * the rest is spent summing gradients and waiting for the slowest replica
+     */
+    [[nodiscard]] double efficiency() const;
+
+    /**
+     * @brief get the time spent summing gradients since the last reset, summed over the replicas
+     */
+    [[nodiscard]] double reduceSeconds() const;
+
+    /**
+     * @brief reset the statistics
+     */
+    void resetStatistics();
+};
+
+#endif // DATA_PARALLEL_HPP
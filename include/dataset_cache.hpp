@@ -0,0 +1,81 @@
+#ifndef DATASET_CACHE_HPP
+#define DATASET_CACHE_HPP
+
+#include "module/dataset.hpp"
+
+/**
+ * @brief The DatasetCache class stores datasets after they are split and scaled in a binary file per dataset, later runs
+ * map the file and use the stored samples without reading, splitting or scaling them again.
+ * A cache file is named after a hash of the path, size and modification time of the input files, the preprocessing
+ * parameters and the version of the format, so a changed input or parameter creates a new file instead of reading a
+ * stale one. A hit neither maps nor reads the input files. The file stores the split training and validation sets, runs
+ * without a seed reuse the stored split, in deterministic mode (Random::setSeed) the seed is part of the name as well.
+ * Files are written under a temporary name and renamed, so concurrent runs never see a half-written file.
+ */
+class DatasetCache
+{
+    static constexpr std::uint32_t msVersion = 1;
+    static constexpr std::array<char, 8> msMagic = {'B', 'R', 'A', 'I', 'N', 'E', 'T', 'C'};
+
+    /**
+     * @brief the beginning of a cache file
+     */
+    struct Header
+    {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t precisionBytes;  // sizeof(Precision) of the transformations
+        std::uint64_t key;
+        std::uint64_t size;            // the size of the file
+    };
+
+    /**
+     * @brief the description of a stored SampleStorage, the headers of the six sets follow the file header
+     */
+    struct Section
+    {
+        std::uint64_t width;
+        std::uint64_t count;           // the number of values
+        std::uint64_t values;          // the position of the values in the file
+        std::uint64_t transformation;  // the position of the scale and offset per feature, 0 for no transformation
+        SampleStorage::Type type;
+        bool bigEndian;
+    };
+
+    std::filesystem::path mDirectory;
+
+    /**
+     * @brief hash bytes, eight at a time
+     */
+    static std::uint64_t mHash(const std::byte *pBytes, std::uint64_t size, std::uint64_t seed);
+
+    /**
+     * @brief write the sets to a file
+     */
+    static void mWrite(const std::filesystem::path &path, std::uint64_t key, const std::array<const SampleStorage *, 6> &sets);
+
+    /**
+     * @brief map a file and view its sets, fails if the file does not exist or does not match the key
+     */
+    static bool mRead(const std::filesystem::path &path, std::uint64_t key, std::array<SampleStorage, 6> &sets);
+
+public:
+    /**
+     * @param directory the directory of the cache files, created on the first write
+     */
+    explicit DatasetCache(const std::string &directory);
+
+    /**
+     * @brief load a dataset of IDX files from the cache, or read, split and scale it and store it in the cache
+     * @param trainingData the samples of the training and validation set
+     * @param trainingLabels the labels of the training and validation set
+     * @param testData the samples of the test set
+     * @param testLabels the labels of the test set
+     * @param validationSplit the share of the training samples used for training, the rest is used for validation
+     * @param normalize divide the samples by the largest value of the training set, see Dataset::normalize
+     * @param name the name of the dataset
+     */
+    [[nodiscard]] Dataset loadIdx(const std::string &trainingData, const std::string &trainingLabels, const std::string &testData, const std::string &testLabels, double validationSplit, bool normalize, const std::string &name = "") const;
+};
+
+#endif // DATASET_CACHE_HPP
@@ -0,0 +1,109 @@
+#ifndef GEMM_HPP
+#define GEMM_HPP
+
+#include "dependencies.hpp"
+#include "config.hpp"
+#include "packed_matrix.hpp"
+
+/**
+ * @brief The Gemm class implements general matrix products C = op(A) * op(B) of row-major matrices, where op optionally transposes.
+ * All products of one call are scheduled in a single parallel region: large products are split into tiles,
+ * small products are packed together into work items, and the threads claim the items from a shared counter.
+ * The tile sizes and the number of threads are tuned per problem shape, see GemmTuner.
+ */
+class Gemm
+{
+public:
+    /**
+     * @brief one matrix product, op(A) is m x k, op(B) is k x n and C is m x n
+     */
+    struct Problem
+    {
+        const Precision *a = nullptr; // A, stored k x m if transposeA
+        const Precision *b = nullptr; // B, stored n x k if transposeB
+        Precision *c = nullptr;
+        std::uint64_t m = 0;
+        std::uint64_t n = 0;
+        std::uint64_t k = 0;
+        bool transposeA = false;
+        bool transposeB = false;
+        bool accumulate = false; // C += op(A) * op(B) instead of C = op(A) * op(B)
+        const PackedMatrix *packedB = nullptr; // op(B) packed into panels, replaces b and transposeB if set
+    };
+
+    /**
+     * @brief the blocking parameters of the kernels, chosen per problem shape by the GemmTuner
+     */
+    struct Config
+    {
+        std::uint64_t rowBlock = 64;     // rows of C per tile
+        std::uint64_t columnBlock = 256; // columns of C per tile
+        std::uint64_t depthBlock = 256;  // length of the k panels that are kept in cache
+        std::uint32_t threads = 0;       // threads to use, 0 for Parallel::threadCount()
+    };
+
+private:
+    friend class GemmTuner;
+
+    /**
+     * @brief a tile of one product or a group of whole small products
+     */
+    struct WorkItem
+    {
+        std::uint64_t firstProblem;
+        std::uint64_t lastProblem; // exclusive
+        std::uint64_t rowBegin, rowEnd;
+        std::uint64_t columnBegin, columnEnd;
+    };
+
+    /**
+     * @brief compute the tile [rowBegin, rowEnd) x [columnBegin, columnEnd) of C, packing transposed operands into row-major panels
+     * unless B is already packed
+     */
+    static void tile(const Problem &problem, const Config &config, std::uint64_t rowBegin, std::uint64_t rowEnd, std::uint64_t columnBegin, std::uint64_t columnEnd);
+
+    /**
+     * @brief C (+)= A * B for row-major panels with the given row strides, B is stored as Precision or BFloat16
+     */
+    template <typename T>
+    static void kernel(const Precision *a, std::uint64_t lda, const T *b, std::uint64_t ldb, Precision *c, std::uint64_t ldc, std::uint64_t m, std::uint64_t n, std::uint64_t k, std::uint64_t depthBlock, bool accumulate);
+
+    /**
+     * @brief split the products into work items and execute them in parallel
+     */
+    static void schedule(const std::vector<Problem> &problems, const Config &config);
+
+public:
+    /**
+     * @brief compute a single product
+     * @param problem the matrices and their sizes
+     */
+    static void multiply(const Problem &problem);
+
+    /**
+     * @brief compute a single product with the given configuration instead of the tuned one,
+     * e.g. with one thread inside a thread that owns the operands
+     * @param problem the matrices and their sizes
+     * @param config the blocking parameters and the number of threads
+     */
+    static void multiply(const Problem &problem, const Config &config);
+
+    /**
+     * @brief compute batch products of the same size whose matrices are evenly spaced in memory,
+     * product i uses a + i * strideA, b + i * strideB and c + i * strideC
+     * @param problem the first product
+     * @param batch the number of products
+     * @param strideA the distance between two A matrices, 0 to share A between all products
+     * @param strideB the distance between two B matrices, 0 to share B between all products
+     * @param strideC the distance between two C matrices
+     */
+    static void stridedBatched(const Problem &problem, std::uint64_t batch, std::uint64_t strideA, std::uint64_t strideB, std::uint64_t strideC);
+
+    /**
+     * @brief compute products of different sizes in one parallel region
+     * @param problems the products, their C matrices must not overlap
+     */
+    static void batched(const std::vector<Problem> &problems);
+};
+
+#endif // GEMM_HPP
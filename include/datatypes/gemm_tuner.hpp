@@ -0,0 +1,80 @@
+#ifndef GEMM_TUNER_HPP
+#define GEMM_TUNER_HPP
+
+#include "gemm.hpp"
+
+/**
+ * @brief The GemmTuner class picks the blocking parameters and the number of threads of the Gemm kernels.
+ * Tuning is disabled by default. When it is enabled, the first time a problem shape (bucketed m, n, k and batch size,
+ * transposes, element type, thread count) is seen, candidate configurations are timed on scratch matrices of that shape
+ * and the fastest one is kept. Other threads that need the same shape meanwhile use the default configuration instead of
+ * waiting. The results are appended to a cache file in the cache directory, keyed by the CPU model, so later runs on the
+ * same kind of machine start tuned.
+ * @note All configurations add the products along k in the same order, so tuning never changes the results.
+ */
+class GemmTuner
+{
+    static std::map<std::string, Gemm::Config> msConfigs; // the tuned configurations of the current CPU
+    static std::set<std::string> msTuning;                // the shapes that are being tuned by some thread
+    static std::mutex msMutex;
+    static std::atomic<bool> msEnabled;
+    static bool msLoaded;
+    static std::filesystem::path msCacheDirectory;
+
+    static constexpr const char *msCacheFile = "gemm_tuning.cache";
+
+    static constexpr std::uint64_t msMinimumWork = 1 << 20;       // smaller products use the default configuration
+    static constexpr std::uint64_t msMaximumScratch = 1 << 24;    // larger problems are not benchmarked, they use the default configuration
+    static constexpr std::uint32_t msRepetitions = 3;             // every candidate is timed this often, the fastest run counts
+
+    /**
+     * @brief get the model name of the CPU from /proc/cpuinfo
+     */
+    static std::string cpuModel();
+
+    /**
+     * @brief get the cache key of a problem, sizes are rounded up to powers of two
+     */
+    static std::string key(const Gemm::Problem &problem, std::uint64_t batch);
+
+    /**
+     * @brief read the configurations of the current CPU from the cache file
+     */
+    static void load();
+
+    /**
+     * @brief append a configuration to the cache file, creates the cache directory
+     */
+    static void store(const std::string &key, const Gemm::Config &config);
+
+    /**
+     * @brief time the candidates on scratch matrices of the problem's shape and return the fastest
+     */
+    static Gemm::Config tune(const Gemm::Problem &problem, std::uint64_t batch);
+
+public:
+    /**
+     * @brief get the configuration for a problem, tunes it if tuning is enabled and the shape is new
+     * @param problem the product (only its sizes and transposes are used)
+     * @param batch the number of products of this shape that are computed together
+     */
+    static Gemm::Config config(const Gemm::Problem &problem, std::uint64_t batch);
+
+    /**
+     * @brief enable or disable tuning, disabled tuning uses the default configuration
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @brief set the directory of the file the tuning results are stored in
+     * @param directory the cache directory, "data/cache" by default, created on the first write
+     */
+    static void setCacheDirectory(const std::filesystem::path &directory);
+
+    /**
+     * @brief forget the tuned configurations in memory, they are read from the cache file again on the next use
+     */
+    static void clear();
+};
+
+#endif // GEMM_TUNER_HPP
@@ -0,0 +1,33 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include "dependencies.hpp"
+
+/**
+ * @brief The MappedFile class maps a file read-only into memory. The pages are loaded by the operating system when they
+ * are first touched and can be dropped again under memory pressure, so opening a large file costs no read and no copy.
+ * Where memory mapping is not available the file is read into a buffer.
+ */
+class MappedFile
+{
+    const std::byte *mpData = nullptr;
+    std::uint64_t mSize = 0;
+    std::vector<std::byte> mBuffer; // the content if the file is not mapped
+
+public:
+    /**
+     * @brief map a whole file
+     * @param path the path of the file
+     */
+    explicit MappedFile(const std::string &path);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile();
+
+    [[nodiscard]] const std::byte *data() const;
+    [[nodiscard]] std::uint64_t size() const;
+};
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,66 @@
+#ifndef PACKED_MATRIX_HPP
+#define PACKED_MATRIX_HPP
+
+#include "dependencies.hpp"
+#include "config.hpp"
+#include "reduced_precision.hpp"
+
+/**
+ * @brief The PackedMatrix class stores the right operand B (k x n) of matrix products in the panel format the Gemm kernels read.
+ * The columns are split into panels of panelWidth columns and every panel is stored as a contiguous k x width block,
+ * so a tile of the product streams through one dense block instead of rows that lie n elements apart, and transposed
+ * operands do not have to be packed again by every product. Packing once pays off for operands that are used by many
+ * products, e.g. weights that only change when the optimizer writes them.
+ * The panels can be stored in bfloat16 to halve the memory traffic, the products are still computed in Precision.
+ */
+class PackedMatrix
+{
+    std::uint64_t mRows = 0;       // k
+    std::uint64_t mColumns = 0;    // n
+    std::uint64_t mPanelWidth = 0; // columns per panel, the last panel can be narrower
+    bool mReduced = false;
+    std::vector<Precision> mPanels;
+    std::vector<BFloat16> mReducedPanels;
+
+public:
+    static constexpr std::uint64_t msDefaultPanelWidth = 256; // the default column block of the Gemm kernels
+
+    /**
+     * @brief pack a row-major matrix
+     * @param source the matrix, stored k x n, or n x k if transpose
+     * @param rows k, the rows of B
+     * @param columns n, the columns of B
+     * @param transpose pack the transposed source, i.e. B = source^T
+     * @param reduced store the panels in bfloat16
+     * @param panelWidth the columns per panel
+     */
+    PackedMatrix(const Precision *source, std::uint64_t rows, std::uint64_t columns, bool transpose, bool reduced = false, std::uint64_t panelWidth = msDefaultPanelWidth);
+
+    [[nodiscard]] std::uint64_t rows() const { return mRows; }
+    [[nodiscard]] std::uint64_t columns() const { return mColumns; }
+    [[nodiscard]] std::uint64_t panelWidth() const { return mPanelWidth; }
+    [[nodiscard]] bool reduced() const { return mReduced; }
+
+    /**
+     * @brief get the number of columns of a panel
+     */
+    [[nodiscard]] std::uint64_t width(const std::uint64_t panel) const { return std::min(mPanelWidth, mColumns - panel * mPanelWidth); }
+
+    /**
+     * @brief get the first element of a panel, T is Precision or BFloat16 depending on reduced()
+     */
+    template <typename T>
+    [[nodiscard]] const T *panel(const std::uint64_t panel) const
+    {
+        if constexpr (std::is_same_v<T, BFloat16>)
+        {
+            return mReducedPanels.data() + panel * mPanelWidth * mRows;
+        }
+        else
+        {
+            return mPanels.data() + panel * mPanelWidth * mRows;
+        }
+    }
+};
+
+#endif // PACKED_MATRIX_HPP
@@ -0,0 +1,106 @@
+#ifndef REDUCED_PRECISION_HPP
+#define REDUCED_PRECISION_HPP
+
+#include "dependencies.hpp"
+
+/**
+ * @brief The BFloat16 type is a 16 bit storage type with the exponent range of float and 8 bits of mantissa.
+ * Values are only stored in 16 bits, all arithmetic is done in float.
+ */
+struct BFloat16
+{
+    std::uint16_t mBits = 0; // the upper 16 bits of the float representation
+
+    BFloat16() = default;
+
+    /**
+     * @brief Convert a float to bfloat16 using round to nearest even.
+     * @param value The value to convert.
+     */
+    BFloat16(float value) // NOLINT: implicit conversion is intended
+    {
+        const auto bits = std::bit_cast<std::uint32_t>(value);
+        if ((bits & 0x7FFFFFFF) > 0x7F800000)
+        {
+            mBits = static_cast<std::uint16_t>(bits >> 16 | 0x0040); // keep NaN a quiet NaN
+            return;
+        }
+        mBits = static_cast<std::uint16_t>((bits + 0x7FFF + (bits >> 16 & 1)) >> 16);
+    }
+
+    operator float() const // NOLINT: implicit conversion is intended
+    {
+        return std::bit_cast<float>(static_cast<std::uint32_t>(mBits) << 16);
+    }
+
+    BFloat16 &operator+=(const float value) { return *this = static_cast<float>(*this) + value; }
+    BFloat16 &operator-=(const float value) { return *this = static_cast<float>(*this) - value; }
+    BFloat16 &operator*=(const float value) { return *this = static_cast<float>(*this) * value; }
+    BFloat16 &operator/=(const float value) { return *this = static_cast<float>(*this) / value; }
+};
+
+/**
+ * @brief The Float16 type is the IEEE 754 half precision storage type with 5 bits of exponent and 10 bits of mantissa.
+ * Values are only stored in 16 bits, all arithmetic is done in float.
+ */
+struct Float16
+{
+    std::uint16_t mBits = 0; // the IEEE 754 binary16 representation
+
+    Float16() = default;
+
+    /**
+     * @brief Convert a float to half precision using round to nearest even.
+     * @param value The value to convert.
+     */
+    Float16(float value); // NOLINT: implicit conversion is intended
+
+    operator float() const; // NOLINT: implicit conversion is intended
+
+    Float16 &operator+=(const float value) { return *this = static_cast<float>(*this) + value; }
+    Float16 &operator-=(const float value) { return *this = static_cast<float>(*this) - value; }
+    Float16 &operator*=(const float value) { return *this = static_cast<float>(*this) * value; }
+    Float16 &operator/=(const float value) { return *this = static_cast<float>(*this) / value; }
+};
+
+/**
+ * @brief The type used to compute with elements of type T. 16 bit storage types are computed in float.
+ */
+template <typename T>
+struct ComputeType
+{
+    using type = T;
+};
+
+template <>
+struct ComputeType<BFloat16>
+{
+    using type = float;
+};
+
+template <>
+struct ComputeType<Float16>
+{
+    using type = float;
+};
+
+/**
+ * @brief Convert n elements from one element type to another.
+ * The generic version converts element by element through the compute type of the source.
+ */
+template <typename S, typename D>
+void convertElements(const S *pSource, D *pDestination, const std::size_t n)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        pDestination[i] = static_cast<D>(static_cast<typename ComputeType<S>::type>(pSource[i]));
+    }
+}
+
+// bulk conversion kernels between float and the 16 bit storage types
+void convertElements(const float *pSource, BFloat16 *pDestination, std::size_t n);
+void convertElements(const BFloat16 *pSource, float *pDestination, std::size_t n);
+void convertElements(const float *pSource, Float16 *pDestination, std::size_t n);
+void convertElements(const Float16 *pSource, float *pDestination, std::size_t n);
+
+#endif // REDUCED_PRECISION_HPP
@@ -0,0 +1,152 @@
+#ifndef REDUCTION_HPP
+#define REDUCTION_HPP
+
+#include "tensor.hpp"
+#include "parallel.hpp"
+
+/**
+ * @brief The Reduction class implements reductions (sum, mean, max, argmax, log-sum-exp) of tensors along arbitrary axes.
+ * Sums use pairwise summation, which keeps the rounding error logarithmic in the number of elements.
+ * The summation order only depends on the shape, never on the number of threads, so results are reproducible.
+ */
+class Reduction
+{
+    typedef std::vector<size_t> ShapeVector;
+
+    static constexpr std::uint64_t msBlockSize = 1 << 12; // elements per independently summed block of a full reduction
+    static constexpr std::uint64_t msBaseSize = 64;       // below this many elements the pairwise recursion sums directly
+
+    enum class Kind
+    {
+        SUM,
+        MAX,
+        LOG_SUM_EXP
+    };
+
+    /**
+     * @brief reduce the tensor along the given axes, reduced axes are kept with size 1
+     */
+    static Tensor reduce(Tensor &input, const ShapeVector &axes, Kind kind);
+
+    /**
+     * @brief reduce the tensor along one axis, the axis is kept with size 1
+     */
+    static Tensor reduceAxis(Tensor &input, size_t axis, Kind kind);
+
+    /**
+     * @brief remove the reduced axes from the shape of a reduced tensor
+     */
+    static void squeeze(Tensor &tensor, const ShapeVector &axes);
+
+public:
+    /**
+     * @brief pairwise summation of element(i) for i in [begin, end)
+     * @param element function returning the i-th summand
+     */
+    template <typename F>
+    static Precision pairwiseSum(F &element, const std::uint64_t begin, const std::uint64_t end)
+    {
+        if (end - begin <= msBaseSize)
+        {
+            Precision partial[8] = {}; // independent accumulators the compiler can keep in one vector register
+            std::uint64_t i = begin;
+            for (; i + 8 <= end; i += 8)
+            {
+                for (std::uint32_t lane = 0; lane < 8; lane++)
+                {
+                    partial[lane] += element(i + lane);
+                }
+            }
+            for (; i < end; i++)
+            {
+                partial[0] += element(i);
+            }
+            return ((partial[0] + partial[1]) + (partial[2] + partial[3])) + ((partial[4] + partial[5]) + (partial[6] + partial[7]));
+        }
+        const std::uint64_t middle = begin + (end - begin) / 2;
+        return pairwiseSum(element, begin, middle) + pairwiseSum(element, middle, end);
+    }
+
+    /**
+     * @brief sum element(i) for i in [0, n) with pairwise summation, large sums are split over threads
+     * @param n the number of summands
+     * @param element function returning the i-th summand
+     * @return the sum
+     */
+    template <typename F>
+    static Precision sumOf(const std::uint64_t n, F element)
+    {
+        if (n <= msBlockSize)
+        {
+            return pairwiseSum(element, 0, n);
+        }
+        // the blocks are fixed, only their distribution over the threads changes
+        const std::uint64_t blocks = (n + msBlockSize - 1) / msBlockSize;
+        std::vector<Precision> partial(blocks);
+        Parallel::forRange(blocks, n, [&](const std::uint64_t first, const std::uint64_t last) {
+            for (std::uint64_t block = first; block < last; block++)
+            {
+                partial[block] = pairwiseSum(element, block * msBlockSize, std::min(n, (block + 1) * msBlockSize));
+            }
+        });
+        auto partialElement = [&](const std::uint64_t i) { return partial[i]; };
+        return pairwiseSum(partialElement, 0, blocks);
+    }
+
+    /**
+     * @brief sum of all elements
+     */
+    static Precision sum(Tensor &input);
+
+    /**
+     * @brief mean of all elements
+     */
+    static Precision mean(Tensor &input);
+
+    /**
+     * @brief maximum of all elements
+     */
+    static Precision max(Tensor &input);
+
+    /**
+     * @brief sum along the given axes
+     * @param input the tensor to reduce
+     * @param axes the axes to reduce
+     * @param keepDims keep the reduced axes with size 1
+     */
+    static Tensor sum(Tensor &input, const ShapeVector &axes, bool keepDims = false);
+
+    /**
+     * @brief mean along the given axes
+     * @param input the tensor to reduce
+     * @param axes the axes to reduce
+     * @param keepDims keep the reduced axes with size 1
+     */
+    static Tensor mean(Tensor &input, const ShapeVector &axes, bool keepDims = false);
+
+    /**
+     * @brief maximum along the given axes
+     * @param input the tensor to reduce
+     * @param axes the axes to reduce
+     * @param keepDims keep the reduced axes with size 1
+     */
+    static Tensor max(Tensor &input, const ShapeVector &axes, bool keepDims = false);
+
+    /**
+     * @brief numerically stable log(sum(exp(x))) along the given axes
+     * @param input the tensor to reduce
+     * @param axes the axes to reduce
+     * @param keepDims keep the reduced axes with size 1
+     */
+    static Tensor logSumExp(Tensor &input, const ShapeVector &axes, bool keepDims = false);
+
+    /**
+     * @brief index of the maximum along one axis, the first index wins ties
+     * @param input the tensor to reduce
+     * @param axis the axis to reduce
+     * @param keepDims keep the reduced axis with size 1
+     */
+    static Tensor argmax(Tensor &input, size_t axis, bool keepDims = false);
+};
+
+#endif // REDUCTION_HPP
@@ -0,0 +1,155 @@
+#ifndef SAMPLE_STORAGE_HPP
+#define SAMPLE_STORAGE_HPP
+
+#include "tensor.hpp"
+
+/**
+ * @brief The SampleStorage class stores the samples (or the labels) of a dataset in one contiguous row-major buffer.
+ * Every sample is a row of the same width, e.g. a class index is a row of width 1, so there is no allocation per sample
+ * and batches are assembled by copying whole rows.
+ * Samples can be kept in their native type and byte order (e.g. the bytes of an image or the big-endian values of a
+ * mapped file), they are converted to Precision when a row is copied. An affine transformation per feature
+ * (value * scale + offset, e.g. normalization or standardization) is applied in the same pass, so the stored samples are
+ * never modified. Copies of a storage share the values, a selection of rows (e.g. the training part of a split) shares
+ * them as well and only stores the indices of its rows.
+ */
+class SampleStorage
+{
+public:
+    /**
+     * @brief the element type of the stored values
+     */
+    enum class Type : std::uint8_t
+    {
+        UINT8,
+        INT8,
+        INT16,
+        INT32,
+        FLOAT32,
+        FLOAT64
+    };
+
+    static constexpr Type PRECISION = std::is_same_v<Precision, float> ? Type::FLOAT32 : Type::FLOAT64;
+
+private:
+    std::shared_ptr<const void> mpOwner;  // keeps the values alive, e.g. a vector or a mapped file
+    const std::byte *mpValues = nullptr;
+    std::uint64_t mCount = 0;             // the number of values
+    Type mType = PRECISION;
+    bool mSwap = false;                   // the values are stored in the other byte order
+    std::uint64_t mWidth = 0;
+    std::shared_ptr<const std::vector<std::uint32_t>> mpRows; // the stored rows in the order they are exposed, nullptr for all rows in order
+    std::vector<Precision> mScale;        // per feature, empty for no transformation
+    std::vector<Precision> mOffset;
+
+    /**
+     * @brief reverse the bytes of a value
+     */
+    template <typename T>
+    static T mSwapBytes(T value);
+
+    /**
+     * @brief convert and transform count values, a loop the compiler vectorizes
+     */
+    template <typename T, bool Swap>
+    static void mConvert(const std::byte *pSource, const Precision *pScale, const Precision *pOffset, Precision *pDestination, std::uint64_t count);
+
+    /**
+     * @brief convert count values starting at a value of any type
+     */
+    void mConvert(std::uint64_t first, std::uint64_t count, const Precision *pScale, const Precision *pOffset, Precision *pDestination) const;
+
+    /**
+     * @brief check that the values fill whole rows
+     */
+    void mCheckWidth() const;
+
+public:
+    SampleStorage() = default;
+
+    /**
+     * @brief take over a row-major buffer
+     * @param values the values of all rows
+     * @param width the number of values of a row
+     */
+    SampleStorage(std::vector<Precision> values, std::uint64_t width);
+
+    /**
+     * @brief take over a row-major buffer of bytes, e.g. pixels or class indices
+     * @param values the values of all rows
+     * @param width the number of values of a row
+     */
+    SampleStorage(std::vector<std::uint8_t> values, std::uint64_t width);
+
+    /**
+     * @brief view a row-major buffer owned by another object without copying it
+     * @param pOwner the owner of the buffer, kept alive as long as the storage (or a copy) exists
+     * @param pValues the first value
+     * @param type the type of the values
+     * @param bigEndian the byte order of the values
+     * @param count the number of values
+     * @param width the number of values of a row
+     */
+    SampleStorage(std::shared_ptr<const void> pOwner, const std::byte *pValues, Type type, bool bigEndian, std::uint64_t count, std::uint64_t width);
+
+    /**
+     * @brief copy rows of equal width into one buffer
+     */
+    explicit SampleStorage(const std::vector<std::vector<Precision>> &rows);
+
+    /**
+     * @brief select rows of another storage without copying them, the type and the transformation are kept
+     * @param source the storage to select from
+     * @param indices the rows of the source in the order they are exposed
+     */
+    SampleStorage(const SampleStorage &source, const std::vector<std::uint32_t> &indices);
+
+    /**
+     * @brief get the number of bytes of a value of a type
+     */
+    static std::uint64_t elementSize(Type type);
+
+    [[nodiscard]] std::uint64_t size() const;
+    [[nodiscard]] std::uint64_t width() const;
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] Type type() const;
+
+    /**
+     * @brief get a row in the stored type and byte order, e.g. to write it to a file
+     */
+    [[nodiscard]] const std::byte *rawRow(std::uint64_t index) const;
+    [[nodiscard]] bool bigEndian() const;
+
+    /**
+     * @brief get the transformation per feature, empty for no transformation
+     */
+    [[nodiscard]] const std::vector<Precision> &scale() const;
+    [[nodiscard]] const std::vector<Precision> &offset() const;
+
+    /**
+     * @brief get the number of bytes of the values of the rows
+     */
+    [[nodiscard]] std::uint64_t bytes() const;
+
+    /**
+     * @brief set the transformation applied when rows are copied
+     * @param scale the factor of every feature, a single value for all features, empty for no transformation
+     * @param offset the value added to every feature after scaling, a single value for all features
+     */
+    void setTransformation(const std::vector<Precision> &scale, const std::vector<Precision> &offset);
+
+    /**
+     * @brief convert a row to Precision and apply the transformation
+     * @param index the row
+     * @param pDestination width() values
+     * @param transform apply the transformation, false for the stored values, e.g. to compute statistics
+     */
+    void copyRow(std::uint64_t index, Precision *pDestination, bool transform = true) const;
+
+    /**
+     * @brief get all rows as a matrix
+     */
+    [[nodiscard]] std::shared_ptr<Tensor> tensor() const;
+};
+
+#endif // SAMPLE_STORAGE_HPP
@@ -0,0 +1,77 @@
+#ifndef SPARSE_MATRIX_HPP
+#define SPARSE_MATRIX_HPP
+
+#include "matrix.hpp"
+
+/**
+ * @brief The SparseMatrix class stores a matrix in the compressed sparse row (CSR) format.
+ * Only the non-zero elements are stored together with their column index, the row offsets tell where each row starts.
+ * It is used to multiply mostly zero inputs without touching the zeros.
+ */
+class SparseMatrix
+{
+    typedef std::vector<size_t> ShapeVector;
+
+    std::vector<Precision> mValues;               // the non-zero values in row-major order
+    std::vector<std::uint32_t> mColumnIndices;    // the column of every non-zero value
+    std::vector<std::uint32_t> mRowOffsets;       // the index of the first value of every row, has rows + 1 entries
+    ShapeVector mShape = {0, 0};                  // the shape of the dense matrix
+
+public:
+    SparseMatrix() = default;
+
+    /**
+     * @brief Compress a dense matrix. All elements that are exactly zero are dropped.
+     * @param dense The dense matrix.
+     */
+    explicit SparseMatrix(Matrix &dense);
+
+    /**
+     * @brief Create a sparse matrix from coordinates (COO format). Duplicate coordinates are summed.
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param rowIndices The row of every value.
+     * @param colIndices The column of every value.
+     * @param values The values.
+     */
+    SparseMatrix(std::uint32_t rows, std::uint32_t cols, const std::vector<std::uint32_t> &rowIndices, const std::vector<std::uint32_t> &colIndices, const std::vector<Precision> &values);
+
+    /**
+     * @brief Calculate the fraction of elements that are exactly zero.
+     * @param dense The dense matrix.
+     * @return The sparsity in [0, 1].
+     */
+    static Precision sparsity(Matrix &dense);
+
+    /**
+     * @brief Expand the matrix to a dense matrix.
+     * @return The dense matrix.
+     */
+    [[nodiscard]] Matrix toDense() const;
+
+    /**
+     * @brief Calculate this × right.
+     * @param right The dense right matrix with shape (cols, n).
+     * @param result The dense result with shape (rows, n). Will be overwritten.
+     */
+    void multiply(Matrix &right, Matrix &result) const;
+
+    /**
+     * @brief Calculate this^T × right. This is the weight gradient of a sparse input multiplied with the weights.
+     * @param right The dense right matrix with shape (rows, n).
+     * @param result The dense result with shape (cols, n). Will be overwritten.
+     */
+    void transposeMultiply(Matrix &right, Matrix &result) const;
+
+    /**
+     * @brief The number of stored non-zero elements.
+     */
+    [[nodiscard]] size_t nonZeros() const;
+
+    /**
+     * @brief The shape of the dense matrix.
+     */
+    [[nodiscard]] const ShapeVector &shape() const;
+};
+
+#endif // SPARSE_MATRIX_HPP
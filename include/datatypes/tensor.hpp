@@ -3,18 +3,25 @@
 
 #include "dependencies.hpp"
 #include "config.hpp"
+#include "reduced_precision.hpp"
+#include "transpose.hpp"
 
 
 /**
  * @brief The tensor class is an implementation of a tensor.
  * It is used to store data in a multidimensional array.
  * To do this, it uses a vector to store the data and a vector to store the shape of the tensor.
+ * The element type T is the storage type of the tensor. Element access always uses the compute type of T,
+ * so 16 bit storage types (BFloat16, Float16) are read and written as float.
+ * @note The graph uses Tensor, which stores elements in Precision.
  */
-class Tensor
+template <typename T>
+class BasicTensor
 {
 protected:
-    typedef std::vector<Precision> DataVector;
+    typedef std::vector<T> DataVector;
     typedef std::vector<size_t> ShapeVector;
+    typedef typename ComputeType<T>::type Value;
 
     DataVector mData;   // the data of the tensor
     ShapeVector mShape; // the shape of the tensor
@@ -25,114 +32,114 @@ public:
     /**
      * @brief Construct an empty new Tensor object.
      */
-    Tensor() = default;
+    BasicTensor() = default;
 
     /**
      * @brief Construct a new Tensor object. The tensor is initialized with random values.
      * @param dimensionality The dimensionality of the tensor.
      */
-    explicit Tensor(const ShapeVector &dimensionality);
+    explicit BasicTensor(const ShapeVector &dimensionality);
 
     /**
      * @brief Construct a new Tensor object. The tensor is initialized with a given value.
      * @param dimensionality The dimensionality of the tensor.
      * @param value The value to initialize the tensor with.
      */
-    Tensor(const ShapeVector &dimensionality, const Precision &value);
+    BasicTensor(const ShapeVector &dimensionality, const Value &value);
 
     /**
      * @brief Construct a new Tensor object. The tensor is initialized with the data of another tensor.
      * @param tensor The tensor to copy the data from.
      */
-    Tensor(const Tensor &tensor);
+    BasicTensor(const BasicTensor &tensor);
 
-    Tensor& operator=(const Tensor &tensor);
+    BasicTensor& operator=(const BasicTensor &tensor);
 
-    ~Tensor() = default;
+    ~BasicTensor() = default;
 
     /**
      * @brief This function is used to access the data of the tensor. To do so, it uses a vector of indices.
      * @param index The indices of the element.
      * @return The element at the given position.
      */
-    Precision at(const ShapeVector &index);
+    Value at(const ShapeVector &index);
 
     /**
      * @brief This function is used to access the data of the tensor with a single index.
      * @param index The index of the element.
      * @return The element at the given index.
      */
-    Precision at(const size_t &index);
+    Value at(const size_t &index);
 
     /**
      * @brief This function is used to set the value of an element in the tensor. To do so, it uses a vector of indices.
      * @param index The indices of the element.
      * @param value The value to be set.
      */
-    void set(const ShapeVector &index, const Precision &value);
+    void set(const ShapeVector &index, const Value &value);
 
     /**
      * @brief This function is used to set the value of an element in the tensor with a single index.
      * @param index The index of the element.
      * @param value The value to be set.
      */
-    void set(const size_t &index, const Precision &value);
+    void set(const size_t &index, const Value &value);
 
     /**
      * @brief This function is used to add a value to the tensor. To do so, it uses a vector of indices.
      * @param index The indices of the element.
      * @param value The value to be added.
      */
-    void add(const ShapeVector &index, const Precision &value);
+    void add(const ShapeVector &index, const Value &value);
 
     /**
      * @brief This function is used to add a value to the tensor with a single index.
      * @param index The index of the element.
      * @param value The value to be added.
      */
-    void add(const size_t &index, const Precision &value);
+    void add(const size_t &index, const Value &value);
 
     /**
      * @brief This function is used to subtract a value from the tensor. To do so, it uses a vector of indices.
      * @param index The indices of the element.
      * @param value The value to be subtracted.
      */
-    void subtract(const ShapeVector &index, const Precision &value);
+    void subtract(const ShapeVector &index, const Value &value);
 
     /**
      * @brief This function is used to subtract a value from the tensor with a single index.
      * @param index The index of the element.
      * @param value The value to be subtracted.
      */
-    void subtract(const size_t &index, const Precision &value);
+    void subtract(const size_t &index, const Value &value);
 
     /**
      * @brief This function is used to multiply a value with the tensor. To do so, it uses a vector of indices.
      * @param index The indices of the element.
      * @param value The value to be multiplied.
      */
-    void multiply(const ShapeVector &index, const Precision &value);
+    void multiply(const ShapeVector &index, const Value &value);
 
     /**
      * @brief This function is used to multiply a value with the tensor with a single index.
      * @param index The index of the element.
      * @param value The value to be multiplied.
      */
-    void multiply(const size_t &index, const Precision &value);
+    void multiply(const size_t &index, const Value &value);
 
     /**
      * @brief This function is used to divide the tensor by a value. To do so, it uses a vector of indices.
      * @param index The indices of the element.
      * @param value The value to be divided by.
      */
-    void divide(const ShapeVector &index, const Precision &value);
+    void divide(const ShapeVector &index, const Value &value);
 
     /**
      * @brief This function is used to divide the tensor by a value with a single index.
      * @param index The index of the element.
      * @param value The value to be divided by.
      */
-    void divide(const size_t &index, const Precision &value);
+    void divide(const size_t &index, const Value &value);
 
     /**
      * @brief This function returns the shape of the tensor.
@@ -170,6 +177,47 @@ public:
      * @param dimensionality The new dimensionality of the tensor.
      */
     void reshape(const ShapeVector &dimensionality);
+
+    /**
+     * @brief This function returns a pointer to the contiguous row-major storage of the tensor.
+     * @return The pointer to the first element.
+     */
+    T *data();
+
+    /**
+     * @brief This function returns a pointer to the contiguous row-major storage of the tensor.
+     * @return The pointer to the first element.
+     */
+    const T *data() const;
+
+    /**
+     * @brief This function permutes the axes of the tensor.
+     * @param axes The permutation, axis i of the result is axis axes[i] of this tensor.
+     * @return The permuted tensor with contiguous row-major storage.
+     */
+    BasicTensor permute(const ShapeVector &axes) const;
+
+    /**
+     * @brief This function swaps the last two axes of the tensor, e.g. transposes a matrix.
+     * @return The transposed tensor with contiguous row-major storage.
+     */
+    BasicTensor transpose() const;
+
+    /**
+     * @brief This function converts the tensor to another element type, e.g. to store it in 16 bits.
+     * @return A tensor with the same shape and the converted elements.
+     */
+    template <typename U>
+    BasicTensor<U> cast() const
+    {
+        BasicTensor<U> result(mShape);
+        convertElements(mData.data(), result.data(), mData.size());
+        return result;
+    }
 };
 
+typedef BasicTensor<Precision> Tensor;         // the tensor type used in the graph
+typedef BasicTensor<BFloat16> BFloat16Tensor;  // tensor stored in bfloat16, computed in float
+typedef BasicTensor<Float16> Float16Tensor;    // tensor stored in half precision, computed in float
+
 #endif // TENSOR_HPP
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef TRANSPOSE_HPP
+#define TRANSPOSE_HPP
+
+#include "dependencies.hpp"
+#include "reduced_precision.hpp"
+
+/**
+ * @brief The Transpose class implements the layout changes of tensors: 2D transposes and N-d axis permutations.
+ * The transposes recursively split the matrix until the tiles fit into the L1 cache (cache-oblivious),
+ * the tiles are transposed in 8x8 blocks held in vector registers where available.
+ * Permutations are reduced to batches of 2D transposes or contiguous row copies.
+ */
+class Transpose
+{
+    typedef std::vector<size_t> ShapeVector;
+
+    static constexpr std::uint64_t msTileSize = 32;   // the recursion stops at tiles of at most msTileSize x msTileSize
+    static constexpr std::uint64_t msBandSize = 256;  // rows of a plane that are transposed by one thread
+
+    /**
+     * @brief transpose a tile of at most msTileSize x msTileSize elements
+     */
+    template <typename T>
+    static void tile(const T *src, std::uint64_t srcStride, T *dst, std::uint64_t dstStride, std::uint64_t rows, std::uint64_t cols);
+
+    /**
+     * @brief cache-oblivious transpose, splits the longer side until the parts are tiles
+     */
+    template <typename T>
+    static void recursive(const T *src, std::uint64_t srcStride, T *dst, std::uint64_t dstStride, std::uint64_t rows, std::uint64_t cols);
+
+public:
+    /**
+     * @brief transpose a row-major rows x cols matrix into a row-major cols x rows matrix
+     * @param src the source matrix
+     * @param dst the destination matrix, must not overlap with the source
+     * @param rows the number of rows of the source
+     * @param cols the number of columns of the source
+     */
+    template <typename T>
+    static void matrix(const T *src, T *dst, std::uint64_t rows, std::uint64_t cols);
+
+    /**
+     * @brief transpose a rows x cols matrix with row stride srcStride into a cols x rows matrix with row stride dstStride,
+     * dst[j * dstStride + i] = src[i * srcStride + j]. Runs on the calling thread, e.g. to pack panels inside a parallel kernel.
+     */
+    template <typename T>
+    static void strided(const T *src, std::uint64_t srcStride, T *dst, std::uint64_t dstStride, std::uint64_t rows, std::uint64_t cols);
+
+    /**
+     * @brief permute the axes of a row-major tensor, axis i of the result is axis axes[i] of the source
+     * @param src the source data
+     * @param dst the destination data, must not overlap with the source
+     * @param shape the shape of the source
+     * @param axes the permutation of the axes
+     */
+    template <typename T>
+    static void permute(const T *src, T *dst, const ShapeVector &shape, const ShapeVector &axes);
+
+    /**
+     * @brief get the shape of a tensor after permuting its axes
+     */
+    static ShapeVector permutedShape(const ShapeVector &shape, const ShapeVector &axes);
+
+    /**
+     * @brief get the permutation that undoes the given permutation
+     */
+    static ShapeVector inverse(const ShapeVector &axes);
+};
+
+#endif // TRANSPOSE_HPP
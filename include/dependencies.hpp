@@ -2,6 +2,7 @@
 #define DEPENDENCIES_HPP
 
 // all external libraries are included here
+#include <cstddef>
 #include <vector>
 #include <stdexcept>
 #include <exception>
@@ -22,5 +23,10 @@
 #include <array>
 #include <string>
 #include <chrono>
+#include <bit>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <sstream>
 
 #endif // DEPENDENCIES_HPP
\ No newline at end of file
@@ -9,9 +9,11 @@
  */
 class Graph 
 {
+public:
     typedef std::shared_ptr<Variable> VariablePtr;
     typedef std::map<VariablePtr, std::shared_ptr<Tensor>> GradTable;
 
+private:
     std::vector<VariablePtr> mVariableVec; // all variables in the graph
     GradTable mGradTable; // the gradient table for the variables
     
@@ -38,6 +40,20 @@ public:
      */
     void forward(std::vector<VariablePtr> & inputVariables) const;
 
+    /**
+     * @brief This function returns the variables the forward pass would visit, in the order it executes them.
+     * @param inputVariables The Variables from which the data is propagated through the graph.
+     * @return std::vector<VariablePtr> The sorted variables.
+     */
+    std::vector<VariablePtr> getTopologicalOrder(std::vector<VariablePtr> & inputVariables) const;
+
+    /**
+     * @brief This function executes the operations of already sorted variables, e.g. of a part of the graph.
+     * Parts that share no variables can be executed by different threads at the same time.
+     * @param sortedVariables The variables in topological order, variables without an operation are skipped.
+     */
+    static void execute(const std::vector<VariablePtr> & sortedVariables);
+
     /**
      * @brief This function calculates the gradients of the target variables with respect to the variables in the differentiated vector.
      * It uses the well-known general backpropagation algorithm
@@ -49,6 +65,34 @@ public:
      */
     void backprop(std::vector<VariablePtr> & targetVariables, std::vector<VariablePtr> & leafVariables, double leafInitValue = 1.0);
 
+    /**
+     * @brief This function calculates the gradients of the target variables starting from given gradients, without using the
+     * gradient table of the graph. Parts of the graph that share no variables can be differentiated by different threads at the same time.
+     * @param targetVariables The variables for which the gradients are calculated.
+     * @param gradTable The gradients the backpropagation starts from, e.g. of the leafs or of the output of a part of the graph.
+     * All calculated gradients are added, so later calls with the same table reuse them.
+     * @return The gradients of the target variables in the same order as the target variables.
+     */
+    static std::vector<std::shared_ptr<Tensor>> computeGradients(const std::vector<VariablePtr> & targetVariables, GradTable & gradTable);
+
+    /**
+     * @brief This function seeds the gradients of the leafs for one of the equal parts a batch is split into, e.g. a
+     * micro-batch or the shard of a replica, so that the gradients of the parts add up to the gradient of the batch.
+     * @param gradTable The gradient table the leafs are added to.
+     * @param leafVariables The leafs of the part.
+     * @param lossVariables The loss variables, they are differentiated per row and get the full leafInitValue.
+     * @param leafInitValue The initial value of the leaf nodes for the whole batch.
+     * @param parts The number of parts, the other leafs (e.g. norms) do not depend on the rows and get a share of the value.
+     */
+    static void seedLeaves(GradTable & gradTable, const std::vector<VariablePtr> & leafVariables, const std::vector<VariablePtr> & lossVariables, double leafInitValue, std::uint32_t parts);
+
+    /**
+     * @brief This function replaces the gradient table, e.g. by gradients that were accumulated outside the graph.
+     * @param variables The variables the gradients belong to.
+     * @param gradients The gradients in the same order as the variables.
+     */
+    void setGradients(const std::vector<VariablePtr> & variables, const std::vector<std::shared_ptr<Tensor>> & gradients);
+
     /**
      * @brief This function returns all variables in the graph.
      * @return std::vector<VariablePtr> The variables in the graph.
@@ -0,0 +1,39 @@
+#ifndef GRAPH_REPLICA_HPP
+#define GRAPH_REPLICA_HPP
+
+#include "graph.hpp"
+
+/**
+ * @brief A GraphReplica is a copy of the part of the graph between the dataset and the loss. It has its own copies of the
+ * operations and of all computed variables, so it can run forward and backward passes on its own thread while other
+ * replicas do the same. The parameters of the replica share the tensors of the model parameters.
+ */
+struct GraphReplica
+{
+    typedef std::shared_ptr<Variable> VariablePtr;
+
+    VariablePtr pData;                   // the rows of the replica
+    VariablePtr pLabels;
+    std::vector<VariablePtr> variables;  // the variables computed by the replica in topological order
+    std::vector<VariablePtr> learnables; // the copies of the learnable variables of the model, in the same order
+    std::vector<VariablePtr> leaves;     // the copies of the gradient variables of the model
+    std::vector<VariablePtr> losses;     // the copies of the loss variables of the model
+    std::vector<std::uint64_t> versions; // the version of every model parameter when its data was last handed to the replica
+
+    /**
+     * @brief copy the part of the graph between the dataset and the loss
+     * @param graphInputs the data and label variable of the dataset followed by the learnable variables
+     * @param learnableVariables the learnable variables of the model
+     * @param gradientVariables the variables the backward pass starts from
+     * @param lossVariables the loss and surrogate loss variables
+     */
+    GraphReplica(std::vector<VariablePtr> &graphInputs, const std::vector<VariablePtr> &learnableVariables, const std::vector<VariablePtr> &gradientVariables, const std::vector<VariablePtr> &lossVariables);
+
+    /**
+     * @brief hand the data of the model parameters that changed since the last call to the replica
+     * @param learnableVariables the learnable variables of the model
+     */
+    void share(const std::vector<VariablePtr> &learnableVariables);
+};
+
+#endif // GRAPH_REPLICA_HPP
@@ -0,0 +1,77 @@
+#ifndef HOGWILD_HPP
+#define HOGWILD_HPP
+
+#include "graph_replica.hpp"
+#include "parallel.hpp"
+#include "module/dataset.hpp"
+#include "optimizer/optimizer_variant.hpp"
+
+/**
+ * @brief The Hogwild class trains a model asynchronously without locks (Hogwild!). Every worker has its own replica of the
+ * graph, so the activations and gradients are private, and runs on its own member of a ThreadTeam with its own group of cores.
+ * The workers take the batches of an epoch from a shared counter, and apply the gradient of every batch directly to the
+ * parameters of the model, which the replicas share. The parameters are never locked: the optimizer reads and writes
+ * every element with relaxed atomic operations, so a worker can read parameters that another worker is updating and
+ * concurrent updates of an element can overwrite each other. This works well when the gradients are sparse and the
+ * updates rarely touch the same elements. Only optimizers that support updateShared (SGD, Momentum) can be used.
+ */
+class Hogwild
+{
+    typedef std::shared_ptr<Variable> VariablePtr;
+
+    std::uint32_t mWorkerCount;
+    std::uint32_t mCoresPerWorker;
+    ThreadTeam mTeam;
+    std::vector<GraphReplica> mReplicas;
+    std::vector<VariablePtr> mModelLearnables; // the learnable variables the replicas were built for
+
+    double mBusySeconds = 0;    // time all workers spent on batches
+    double mWallSeconds = 0;    // time the epochs took
+    double mStaleness = 0;      // updates of other workers between reading and updating the parameters, summed over all updates
+    std::uint64_t mUpdates = 0;
+    std::uint64_t mExamples = 0;
+
+public:
+    /**
+     * @brief create the threads of the workers
+     * @param workers the number of workers, every worker gets an equal share of the cores
+     */
+    explicit Hogwild(std::uint32_t workers);
+
+    /**
+     * @brief train on all batches of the shuffled training set
+     * @param dataset the dataset, its training set must be shuffled and in memory
+     * @param batchSize the size of the batches
+     * @param graphInputs the data and label variable of the dataset followed by the learnable variables
+     * @param learnableVariables the variables that are trained, their weights must exist
+     * @param gradientVariables the variables the backward pass starts from
+     * @param lossVariables the loss and surrogate loss variables
+     * @param optimizer the optimizer, it must support updateShared
+     * @return the values of the loss variables for every batch, in the order of the training set
+     */
+    std::vector<std::vector<double>> epoch(Dataset &dataset, std::uint32_t batchSize, std::vector<VariablePtr> &graphInputs, const std::vector<VariablePtr> &learnableVariables, const std::vector<VariablePtr> &gradientVariables, const std::vector<VariablePtr> &lossVariables, OptimizerVariant &optimizer);
+
+    [[nodiscard]] std::uint32_t workerCount() const;
+
+    /**
+     * @brief get the number of training examples processed per second since the last reset
+     */
+    [[nodiscard]] double examplesPerSecond() const;
+
+    /**
+     * @brief get the mean number of updates of other workers a worker did not see when it computed its gradient, since the last reset
+     */
+    [[nodiscard]] double meanStaleness() const;
+
+    /**
+     * @brief get the share of the worker time spent on batches since the last reset, the rest is spent waiting at the end of the epochs
+     */
+    [[nodiscard]] double efficiency() const;
+
+    /**
+     * @brief reset the statistics
+     */
+    void resetStatistics();
+};
+
+#endif // HOGWILD_HPP
@@ -2,8 +2,13 @@
 #define MODEL_HPP
 
 #include "graph.hpp"
+#include "pipeline.hpp"
+#include "data_parallel.hpp"
+#include "hogwild.hpp"
+#include "parameter_server.hpp"
 #include "module/module_variant.hpp"
 #include "optimizer/optimizer_variant.hpp"
+#include "optimizer/loss_scaler.hpp"
 #include "module/dataset.hpp"
 
 /**
@@ -23,8 +28,34 @@ class Model
     std::vector<std::shared_ptr<Module>> mModules; // all modules of the model
     std::map<std::string, std::shared_ptr<Module>> mModuleMap; // map to access modules by name
 
+    bool mLossScaling = false; // the loss is scaled dynamically and steps with overflowed gradients are skipped
+    LossScaler mLossScaler;
+
+    std::shared_ptr<Pipeline> mpPipeline = nullptr; // pipeline parallel training, nullptr to train the whole graph at once
+    std::shared_ptr<DataParallel> mpDataParallel = nullptr; // data parallel training, nullptr to train on the graph of the model
+    std::shared_ptr<Hogwild> mpHogwild = nullptr; // asynchronous lock-free training, nullptr to train synchronously
+    std::shared_ptr<ParameterServer> mpParameterServer = nullptr; // training with worker processes, nullptr to train in this process
+
+    /**
+     * @brief create the weights with a forward pass if they do not exist yet, before the parallel trainers get the model
+     * @details The forward pass uses the loaded batch, or the first batch of the training set if none is loaded.
+     */
+    void createWeights(Dataset &dataset, std::vector<std::shared_ptr<Variable>> &graphInputs, std::uint32_t batchSize) const;
+
     bool earlyStopping(const std::uint32_t &epoch, std::uint32_t &bestEpoch, const std::uint32_t &earlyStoppingPatience, const double &error, double &bestError, std::vector<std::shared_ptr<Tensor>> &bestParameters, const double &trainingError, double &bestTrainingError);
 
+    /**
+     * @brief one forward pass, backward pass and parameter update on the loaded batch
+     * @return false if the update was skipped because the scaled gradients overflowed
+     */
+    bool trainingStep(std::vector<std::shared_ptr<Variable>> &graphInputs, OptimizerVariant &optimizer, std::uint32_t batchSize);
+
+    /**
+     * @brief train on all batches of the shuffled training set and log every batch whose update was applied
+     * @return the mean surrogate loss of the applied batches, infinity if no update was applied
+     */
+    double trainingEpoch(Dataset &dataset, std::vector<std::shared_ptr<Variable>> &graphInputs, OptimizerVariant &optimizer, std::uint32_t batchSize);
+
 public:
 
     std::shared_ptr<Module> addModule(const ModuleVariant &module);
@@ -47,12 +78,81 @@ public:
      */
     void train(Dataset &dataset, const std::string& inputModule, const std::string& lossModule, const std::uint32_t &epochs, const std::uint32_t &batchSize, OptimizerVariant optimizer, const std::uint32_t &earlyStoppingPatience);
 
+    /**
+     * @brief enable dynamic loss scaling
+     * @details The loss is scaled by the loss scaler before the backward pass, steps whose gradients overflow are skipped
+     * and not logged. The activations and gradients keep Precision, 16 bit storage of the weights is set up with
+     * Matmul::setWeightPacking.
+     * @param enabled whether the loss is scaled during training
+     * @param lossScaler the loss scaler, e.g. to choose the initial scale
+     */
+    void setLossScaling(bool enabled, const LossScaler &lossScaler = LossScaler());
+
+    /**
+     * @brief enable pipeline parallel training
+     * @details The layers are split into contiguous groups of about equal parameter count, every group is a stage that runs
+     * on its own thread. Every batch is split into micro-batches that flow through the stages in a 1F1B schedule, the gradients
+     * of the micro-batches are accumulated into one update per batch. The time the stages wait for each other (the pipeline bubble)
+     * is printed after training. The model must be sequential and must not use dropout.
+     * @param stages the number of stages, 1 to disable pipeline parallelism
+     * @param microBatches the number of micro-batches per batch, the batch size must be a multiple of it
+     */
+    void setPipeline(std::uint32_t stages, std::uint32_t microBatches);
+
+    /**
+     * @brief enable synchronous data parallel training
+     * @details The graph of the model is replicated, every replica runs on its own thread with an equal share of the cores
+     * and trains on a contiguous shard of every batch. The gradients are summed over the replicas while the backward pass
+     * is still running and the model takes one optimizer step per batch. The throughput and the share of the time the
+     * replicas spent computing are printed after training. The model must not change after the first training step.
+     * @param replicas the number of replicas, 1 to disable data parallelism
+     */
+    void setDataParallel(std::uint32_t replicas);
+
+    /**
+     * @brief enable asynchronous lock-free training (Hogwild!)
+     * @details Every worker thread has a private replica of the graph, takes the next batch of the epoch, computes its
+     * gradient and updates the shared parameters without locks, so workers read parameters while others update them.
+     * This pays off for sparse gradients, where the updates of the workers rarely touch the same parameters.
+     * Only SGD and Momentum can be used, loss scaling and streamed training sets are not supported. The throughput and the mean number of updates
+     * a worker missed while computing its gradient are printed after training.
+     * @param workers the number of workers, 1 to disable asynchronous training
+     */
+    void setHogwild(std::uint32_t workers);
+
+    /**
+     * @brief enable training with worker processes and a parameter server
+     * @details This process keeps the parameters and the optimizer. For every epoch it forks worker processes with their
+     * own copy of the graph, each one trains on every workers-th batch, pushes the gradients over a Unix domain socket and
+     * pulls the weights after the update. A worker may be at most staleness batches ahead of the slowest one.
+     * The throughput and the mean number of updates the weights of a gradient missed are printed after training.
+     * Loss scaling, tensor parallel (sharded) layers and streamed training sets are not supported, a forked worker has
+     * none of their threads.
+     * @param workers the number of worker processes, 0 to train in this process
+     * @param staleness the number of batches a worker may be ahead of the slowest worker
+     */
+    void setParameterServer(std::uint32_t workers, std::uint32_t staleness = 0);
+
     /**
      * @brief function to test the model
      * @note the function will print the error of the model
      */
     void test(Dataset &dataset, const std::string& inputModule, const std::string& lossModule);
 
+    /**
+     * @brief post-training quantization of all dense layers to int8 weights for inference
+     * @details A random calibration subset of the training set is run through the float model to record the range of the
+     * inputs of every dense layer, then the layers switch to int8 products. The test loss before and after is printed,
+     * together with the memory of the weights.
+     * @param calibrationSize the number of training examples used for calibration
+     */
+    void quantize(Dataset &dataset, const std::string& inputModule, const std::string& lossModule, std::uint32_t calibrationSize = 1024);
+
+    /**
+     * @brief switch all dense layers back to float products
+     */
+    void dequantize();
+
     friend class Ensemble;
 };
 
@@ -7,9 +7,17 @@
 
 #include "module.hpp"
 #include "preprocessing/preprocessing.hpp"
+#include "batch_prefetcher.hpp"
+#include "datatypes/sample_storage.hpp"
+#include "shard_stream.hpp"
 
 /**
  * @brief The Dataset class is used to store the data for storing the training and test data of datasets.
+ * The samples and labels of every set are stored contiguously, a batch is assembled by copying the rows of the shuffled
+ * indices directly into the input tensors. Samples may be stored in their native type, e.g. bytes, the conversion and the
+ * scaling happen while a batch is assembled.
+ * The training set can also be streamed from shards on disk, then the batches are read in order from the ShardStream
+ * and the validation and test set are kept apart (e.g. as mapped files).
  */
 class Dataset final : public Module
 {
@@ -17,26 +25,117 @@ class Dataset final : public Module
     std::shared_ptr<Variable> mLabelVariable; // storing the labels
 
     typedef std::vector<std::vector<Precision>> dataType;
-    dataType mTrainingData;
-    dataType mTrainingLabels;
-    dataType mValidationData;
-    dataType mValidationLabels;
-    dataType mTestData;
-    dataType mTestLabels;
+    SampleStorage mTrainingData;
+    SampleStorage mTrainingLabels;
+    SampleStorage mValidationData;
+    SampleStorage mValidationLabels;
+    SampleStorage mTestData;
+    SampleStorage mTestLabels;
+
+    std::shared_ptr<ShardStream> mpStream; // streams the training set from disk, nullptr if it is in memory
 
     std::vector<std::uint32_t> mTrainingIndices;
     std::uint32_t mIndex = 0;
+    std::mt19937 mShuffleGenerator = Random::generator(Random::Stream::SHUFFLE); // one generator per dataset, so every epoch gets a new order
+
+    std::shared_ptr<BatchPrefetcher> mpPrefetcher = std::make_shared<BatchPrefetcher>(2); // assembles the next batches of loadTrainingBatch, declared last so it stops first
+
+    /**
+     * @brief get the number of examples of the current epoch
+     */
+    [[nodiscard]] std::uint64_t mEpochSize() const;
+
+    /**
+     * @brief get the statistics of the stored samples of the training and the validation set
+     */
+    [[nodiscard]] Preprocessing::Statistics mTrainingStatistics() const;
 
 public:
     Dataset(const dataType &trainingData, const dataType &trainingLabels, const double &validationSplit, const dataType &testData, const dataType &testLabels, const std::string &name = "");
     Dataset(const dataType &trainingData, const dataType &trainingLabels, const dataType &testData, const dataType &testLabels, const std::string &name = "");
 
+    /**
+     * @brief create a dataset from contiguous storage, e.g. filled by a reader, a random part of the training set is used for validation
+     */
+    Dataset(const SampleStorage &trainingData, const SampleStorage &trainingLabels, const double &validationSplit, SampleStorage testData, SampleStorage testLabels, const std::string &name = "");
+
+    /**
+     * @brief create a dataset from contiguous storage without a validation set
+     */
+    Dataset(SampleStorage trainingData, SampleStorage trainingLabels, SampleStorage testData, SampleStorage testLabels, const std::string &name = "");
+
+    /**
+     * @brief create a dataset from contiguous storage that is already split, e.g. loaded from a DatasetCache
+     */
+    Dataset(SampleStorage trainingData, SampleStorage trainingLabels, SampleStorage validationData, SampleStorage validationLabels, SampleStorage testData, SampleStorage testLabels, const std::string &name = "");
+
+    /**
+     * @brief create a dataset whose training set is streamed from disk, the validation set may be empty
+     */
+    Dataset(std::shared_ptr<ShardStream> trainingStream, SampleStorage validationData, SampleStorage validationLabels, SampleStorage testData, SampleStorage testLabels, const std::string &name = "");
 
     [[nodiscard]] bool goodTrainingBatch(const std::uint32_t &batchSize) const;
     [[nodiscard]] bool hasValidationSet() const;
+    [[nodiscard]] std::uint32_t trainingSetSize() const;
+
+    /**
+     * @brief check if the training set is streamed from disk, it can then only be read in order by one thread
+     */
+    [[nodiscard]] bool isStreamed() const;
 
+    /**
+     * @brief get the number of batches goodTrainingBatch accepts in an epoch
+     */
+    [[nodiscard]] std::uint32_t trainingBatchCount(std::uint32_t batchSize) const;
+
+    /**
+     * @brief copy a batch of the shuffled training set without loading it, can be called by several threads at once.
+     * Tensors that nobody else holds and have the right shape are overwritten instead of allocating new ones.
+     * A streamed training set can only be read in order by one thread.
+     * @param first the position of the first example in the shuffled order
+     * @param batchSize the number of examples
+     * @param data the rows of the batch
+     * @param labels the labels of the batch
+     */
+    void gatherTrainingBatch(std::uint32_t first, std::uint32_t batchSize, std::shared_ptr<Tensor> &data, std::shared_ptr<Tensor> &labels) const;
+
+    /**
+     * @brief start a new epoch in a new order
+     * @param completeTrainingSet include the validation set, a streamed training set is never mixed with the validation set
+     */
     void shuffleTrainingSet(bool completeTrainingSet = false);
     void loadTrainingBatch(const std::uint32_t &batchSize);
+
+    /**
+     * @brief configure the background thread that assembles the next batches of loadTrainingBatch while the current one trains
+     * @param depth the number of batches assembled ahead, 2 by default, 0 to assemble every batch when it is loaded
+     */
+    void setPrefetching(std::uint32_t depth);
+
+    /**
+     * @brief scale the samples of all sets while they are loaded, value * scale + offset, the stored samples are not changed
+     */
+    void setScaling(Precision scale, Precision offset = 0);
+
+    /**
+     * @brief scale every feature of the samples of all sets while they are loaded, value * scale[j] + offset[j]
+     * @param scale one value per feature
+     * @param offset one value per feature
+     */
+    void setScaling(const std::vector<Precision> &scale, const std::vector<Precision> &offset);
+
+    /**
+     * @brief divide the samples of all sets by the largest value of the training set while they are loaded
+     * @note A streamed training set has no known maximum, use setScaling.
+     */
+    void normalize();
+
+    /**
+     * @brief shift and scale every feature of all sets to zero mean and unit variance over the training set while they
+     * are loaded, features without variance are only shifted
+     * @note A streamed training set has no known statistics, use setScaling.
+     */
+    void standardize();
     void loadValidationSet() const;
     void loadTestSet() const;
 
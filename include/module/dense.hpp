@@ -3,6 +3,8 @@
 
 #include "../operation/processing/dropout.hpp"
 #include "../operation/matmul.hpp"
+#include "../operation/quantized_matmul.hpp"
+#include "../operation/sharded_matmul.hpp"
 #include "../operation/processing/padding.hpp"
 #include "../operation/activation_function/activation_function_variant.hpp"
 #include "../operation/parameter_norm_penalties/norm_variant.hpp"
@@ -22,6 +24,7 @@ class Dense final : public Layer
     std::shared_ptr<Variable> mpPaddingVariable; // used to pad the input with 1s for the bias
     std::shared_ptr<Variable> mpNormVariable; // used to compute a norm of the weights
     std::shared_ptr<Variable> mpDropoutVariable; // dropout applied to the input
+    std::vector<std::shared_ptr<Variable>> mWeightShardVariables; // the column shards of the weights of a tensor parallel layer, replace mpWeightMatrixVariable
 
     static std::shared_ptr<ParameterNormPenaltyVariant> mpsDefaultNorm; // default norm to use
     std::shared_ptr<Operation> mpNorm = nullptr; // norm to use for regularization
@@ -33,8 +36,9 @@ public:
      * @param units the number of neurons in the layer.
      * @param name the name of the module
      * @param dropout the dropout rate of the layer
+     * @param shards the number of column shards of the weights, each computed by its own thread, see ShardedMatmul
      */
-    Dense(const ActivationVariant &activationFunction, std::uint32_t units, const std::string& name = "", const double& dropout = 1.0);
+    Dense(const ActivationVariant &activationFunction, std::uint32_t units, const std::string& name = "", const double& dropout = 1.0, std::uint32_t shards = 1);
 
     /**
      * @brief add a dense layer to the graph
@@ -42,8 +46,9 @@ public:
      * @param size the number of neurons in the layer.
      * @param name the name of the module
      * @param dropout the dropout rate of the layer
+     * @param shards the number of column shards of the weights, each computed by its own thread, see ShardedMatmul
      */
-    Dense(const std::shared_ptr<Operation> &activationFunction, std::uint32_t size, const std::string& name = "", const double& dropout = 1.0);
+    Dense(const std::shared_ptr<Operation> &activationFunction, std::uint32_t size, const std::string& name = "", const double& dropout = 1.0, std::uint32_t shards = 1);
 
     /**
      * @brief add a dense layer to the graph
@@ -64,6 +69,23 @@ public:
 
     void createWeightMatrix(std::uint32_t n);
 
+    /**
+     * @brief replace the matrix product by an int8 product for inference, the range of the inputs is taken from the
+     * data of the last forward pass, which should have been a representative calibration batch
+     * @return the memory used by the quantized weights in bytes
+     */
+    std::uint64_t quantize();
+
+    /**
+     * @brief go back to the float matrix product, e.g. to continue training
+     */
+    void dequantize();
+
+    /**
+     * @brief get the memory used by the float weights in bytes
+     */
+    [[nodiscard]] std::uint64_t weightBytes() const;
+
     static void setDefaultNorm(ParameterNormPenaltyVariant const &norm);
 };
 
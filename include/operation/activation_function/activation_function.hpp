@@ -25,11 +25,11 @@ public:
     /**
      * @brief Activation function to be implemented by the derived class.
      */
-    virtual double activationFunction(double x) = 0;
+    virtual Precision activationFunction(Precision x) = 0;
     /**
      * @brief Derivative of the activation function to be implemented by the derived class.
      */
-    virtual double activationFunctionDerivative(double x) = 0;
+    virtual Precision activationFunctionDerivative(Precision x) = 0;
 };
 
 #endif // ACTIVATIONFUNCTION_HPP
\ No newline at end of file
@@ -12,15 +12,16 @@ class HeavysideStep : public ActivationFunction
      * @brief The Heavyside step function.
      * @param input The input value.
      */
-    double activationFunction(double input)override;
+    Precision activationFunction(Precision input)override;
     /**
      * @brief The derivative of the Heavyside step function.
      * @param input The input value.
      */
-    double activationFunctionDerivative(double input)override;
+    Precision activationFunctionDerivative(Precision input)override;
 public:
     HeavysideStep() { mName = "HEAVYSIDE_STEP"; };
     ~HeavysideStep() = default;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<HeavysideStep>(*this); }
 };
 
 #endif // HEAVYSIDESTEP_HPP
\ No newline at end of file
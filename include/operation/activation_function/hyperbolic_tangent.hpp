@@ -12,15 +12,16 @@ class HyperbolicTangent : public ActivationFunction
      * @brief The hyperbolic tangent function.
      * @param input The input value.
      */
-    double activationFunction(double input)override;
+    Precision activationFunction(Precision input)override;
     /**
      * @brief The derivative of the hyperbolic tangent function.
      * @param input The input value.
      */
-    double activationFunctionDerivative(double input)override;
+    Precision activationFunctionDerivative(Precision input)override;
 public:
     HyperbolicTangent() { mName = "HYPERBOLIC_TANGENT"; };
     ~HyperbolicTangent() = default;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<HyperbolicTangent>(*this); }
 };
 
 #endif // HYPERBOLICTANGENT_HPP
\ No newline at end of file
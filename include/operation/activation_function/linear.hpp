@@ -12,15 +12,16 @@ class Linear : public ActivationFunction
      * @brief The linear function.
      * @param input The input value.
      */
-    double activationFunction(double input)override;
+    Precision activationFunction(Precision input)override;
     /**
      * @brief The derivative of the linear function.
      * @param input The input value.
      */
-    double activationFunctionDerivative(double input)override;
+    Precision activationFunctionDerivative(Precision input)override;
 public:
     Linear() { mName = "LINEAR"; };
     ~Linear() = default;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<Linear>(*this); }
 };
 
 #endif // LINEAR_HPP
\ No newline at end of file
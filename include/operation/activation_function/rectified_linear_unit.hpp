@@ -8,22 +8,23 @@
 */
 class ReLU : public ActivationFunction
 {
-    double __gradient; // gradient of left part of the function
+    Precision __gradient; // gradient of left part of the function
 
 protected:
     /**
      * @brief The ReLU function.
      * @param input The input value.
     */
-    double activationFunction(double input)override;
+    Precision activationFunction(Precision input)override;
     /**
      * @brief The derivative of the ReLU function.
      * @param input The input value.
     */
-    double activationFunctionDerivative(double input)override;
+    Precision activationFunctionDerivative(Precision input)override;
 public:
-    ReLU(double gradient = 0);
+    ReLU(Precision gradient = 0);
     ~ReLU() = default;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<ReLU>(*this); }
 };
 
 // add Maxout
@@ -12,15 +12,16 @@ class Sigmoid : public ActivationFunction
      * @brief The sigmoid function.
      * @param input The input value.
     */
-    double activationFunction(double input)override;
+    Precision activationFunction(Precision input)override;
     /**
      * @brief The derivative of the sigmoid function.
      * @param input The input value.
     */
-    double activationFunctionDerivative(double input)override;
+    Precision activationFunctionDerivative(Precision input)override;
 public:
     Sigmoid() { mName = "SIGMOID"; };
     ~Sigmoid() = default;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<Sigmoid>(*this); }
 };
 
 #endif // SIGMOID_HPP
\ No newline at end of file
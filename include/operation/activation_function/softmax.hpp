@@ -29,6 +29,7 @@ public:
     ~Softmax() = default;
 
     void useWithLog();
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<Softmax>(*this); }
 };
 
 #endif // SOFTMAX_HPP
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef BATCHED_MATMUL_HPP
+#define BATCHED_MATMUL_HPP
+
+#include "operation.hpp"
+#include "../datatypes/gemm.hpp"
+
+/**
+ * @brief BatchedMatmul class used to multiply a batch of matrices, [batch, m, k] x [batch, k, n] -> [batch, m, n].
+ * One of the inputs may be a single matrix that is shared by the whole batch, e.g. [batch, m, k] x [k, n].
+ * All products are computed in one parallel region, so many small products (ensembles, attention heads) still use all cores.
+ */
+class BatchedMatmul : public Operation
+{
+public:
+    BatchedMatmul() { mName = "BATCHED_MATMUL"; };
+    ~BatchedMatmul() = default;
+
+    /**
+     * @brief multiply the matrices of the batch
+     * @param inputs the left and the right input variable
+     */
+    void f(std::vector<std::shared_ptr<Variable>>& inputs) override;
+
+    /**
+     * @brief the gradient of one side is the batch of products of the gradient with the transposed other side,
+     * summed over the batch for a shared matrix
+     * @param inputs the left and the right input variable
+     * @param focus the variable to calculate the gradient for
+     * @param gradient the sum of the gradients of the consumers
+     */
+    std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient) override;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<BatchedMatmul>(*this); }
+};
+
+#endif // BATCHED_MATMUL_HPP
@@ -0,0 +1,82 @@
+#ifndef EINSUM_HPP
+#define EINSUM_HPP
+
+#include "operation.hpp"
+#include "../datatypes/gemm.hpp"
+
+/**
+ * @brief Einsum class used to contract any number of tensors given by an Einstein summation string, e.g. "bij,bjk->bik".
+ * Every index is a letter. Indices that are missing in the output are summed over. Without "->" the output consists of the
+ * indices that appear exactly once, in alphabetical order. Every pairwise contraction is lowered to a strided batched Gemm
+ * of permuted operands, the pairs are contracted in a greedy order that keeps the intermediate work small.
+ */
+class Einsum : public Operation
+{
+    typedef std::vector<size_t> ShapeVector;
+    typedef std::string Labels;
+
+    std::vector<Labels> mInputLabels; // the indices of every input
+    Labels mOutputLabels;             // the indices of the output
+
+    /**
+     * @brief split the specification into the indices of the inputs and of the output
+     */
+    static void parse(const std::string &specification, std::vector<Labels> &inputs, Labels &output);
+
+    /**
+     * @brief sum over the indices of a tensor that are not in keep, the summed indices are removed from labels
+     */
+    static std::shared_ptr<Tensor> sumOut(const std::shared_ptr<Tensor> &tensor, Labels &labels, const Labels &keep);
+
+    /**
+     * @brief permute a tensor so its indices are in the given order
+     */
+    static std::shared_ptr<Tensor> arrange(const std::shared_ptr<Tensor> &tensor, const Labels &labels, const Labels &order);
+
+    /**
+     * @brief repeat a tensor along the indices of full that are missing in labels
+     */
+    static std::shared_ptr<Tensor> broadcast(const std::shared_ptr<Tensor> &tensor, const Labels &labels, const Labels &full, const std::map<char, size_t> &sizes);
+
+    /**
+     * @brief contract two tensors into a tensor with the batch, left and right indices that are still needed
+     * @param needed the indices used by the output or by other operands
+     * @param labels the indices of the result
+     */
+    static std::shared_ptr<Tensor> contractPair(std::shared_ptr<Tensor> left, Labels leftLabels, std::shared_ptr<Tensor> right, Labels rightLabels, const Labels &needed, const std::map<char, size_t> &sizes, Labels &labels);
+
+public:
+    /**
+     * @brief constructor of the einsum operation
+     * @param specification the Einstein summation string, e.g. "ij,jk->ik"
+     */
+    explicit Einsum(const std::string &specification);
+    ~Einsum() = default;
+
+    /**
+     * @brief contract tensors outside of the graph
+     * @param operands the tensors
+     * @param labels the indices of every tensor
+     * @param output the indices of the result
+     * @return the contracted tensor, a tensor of shape {1} if the output has no indices
+     */
+    static std::shared_ptr<Tensor> contract(std::vector<std::shared_ptr<Tensor>> operands, std::vector<Labels> labels, const Labels &output);
+
+    /**
+     * @brief contract the inputs as given by the specification
+     * @param inputs the input variables
+     */
+    void f(std::vector<std::shared_ptr<Variable>>& inputs) override;
+
+    /**
+     * @brief the gradient of an input is the contraction of the gradient with all other inputs,
+     * repeated along the indices that were summed over in the forward pass
+     * @param inputs the input variables
+     * @param focus the variable to calculate the gradient for
+     * @param gradient the sum of the gradients of the consumers
+     */
+    std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient) override;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<Einsum>(*this); }
+};
+
+#endif // EINSUM_HPP
@@ -21,6 +21,7 @@ public:
      * @note The first input tensor is the prediction and the second input tensor is the target.
      */
     void f(std::vector<std::shared_ptr<Variable>> &inputs) override;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<ErrorRate>(*this); }
 };
 
 #endif // ERROR_RATE_HPP
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "operation.hpp"
 #include "matmul.cuh"
+#include "../datatypes/sparse_matrix.hpp"
+#include "../datatypes/gemm.hpp"
 
 
 /**
@@ -12,23 +14,33 @@
 class Matmul : public Operation
 {   
 protected:
-    static const std::uint32_t threads = 200;
+    static Precision msSparsityThreshold; // fraction of zeros in the left matrix above which the sparse kernels are used
+
+    std::shared_ptr<SparseMatrix> mpSparseLeft = nullptr; // compressed left matrix of the last forward pass
+    std::shared_ptr<Tensor> mpSparseSource = nullptr;     // the tensor mpSparseLeft was compressed from
+
+    static bool msPackWeights;        // keep the right matrix packed as long as its variable does not change
+    static bool msReducedWeights;     // store the packed right matrix in bfloat16
+
     /**
-     * @brief  matrix vector multiplication function
-     * @param left_matrix the left matrix
-     * @param right_matrix the right matrix
-     * @param result the result of the matrix multiplication
-     * @param k the index of the coloum in the right matrix
+     * @brief the packed right matrix and the version of the variable it was packed from
      */
-    void blockmul(Matrix &left_matrix, Matrix &right_matrix, Matrix &result, const std::uint32_t &k, const bool &left_transpose, const bool &right_transpose);
+    struct PackedWeights
+    {
+        std::shared_ptr<PackedMatrix> pMatrix = nullptr;
+        std::shared_ptr<Tensor> pSource = nullptr; // holding the tensor keeps a new tensor from reusing its address
+        std::uint64_t version = 0;
+    };
+    PackedWeights mPackedWeights;           // B, used by the forward pass
+    PackedWeights mPackedWeightsTransposed; // B^T, used by the gradient of the left matrix
 
     /**
-     * @brief spawning threads for every coloum in the right matrix to execute the blockmul function in parallel
-     * @param left_matrix the left matrix
-     * @param right_matrix the right matrix
-     * @param result the result of the matrix multiplication
+     * @brief get the packed right matrix, it is packed again only if the variable changed since the last call
+     * @param right the right input variable
+     * @param transpose pack B^T instead of B
+     * @return the packed matrix or nullptr if the right matrix is computed by an operation (it changes every pass) or packing is disabled
      */
-    void matmul(const std::shared_ptr<Matrix>& left_matrix, const std::shared_ptr<Matrix>& right_matrix, const std::shared_ptr<Matrix>& result, const bool &left_transpose = false, const bool &right_transpose = false);
+    const PackedMatrix *packedWeights(const std::shared_ptr<Variable> &right, bool transpose);
 public:    
     Matmul(){mName = "Matmul";};
     ~Matmul(){};
@@ -44,6 +56,22 @@ public:
      * @param gradient the sum of the gradients of the consumers
      */
     std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient) override;
+
+    /**
+     * @brief set the fraction of zeros in the left matrix above which the sparse × dense kernels are used
+     * @param threshold the sparsity threshold in [0, 1], values above 1 disable the sparse kernels
+     */
+    static void setSparsityThreshold(Precision threshold);
+
+    /**
+     * @brief configure the packed weight cache. Right matrices that are not computed by an operation (weights, inputs)
+     * are packed into the Gemm panel format once and reused until their variable's version changes, i.e. once per
+     * optimizer step during training and never during inference.
+     * @param enabled use the cache, enabled by default
+     * @param reduced store the packed weights in bfloat16, which halves their memory traffic but rounds the weights
+     */
+    static void setWeightPacking(bool enabled, bool reduced = false);
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<Matmul>(); } // the caches are not shared
 };
 
 #endif // MATMUL_HPP
\ No newline at end of file
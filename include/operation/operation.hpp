@@ -5,6 +5,7 @@
 #include "../datatypes/tensor.hpp"
 #include "../datatypes/matrix.hpp"
 #include "../datatypes/vector.hpp"
+#include "../datatypes/reduction.hpp"
 
 class Variable;
 
@@ -36,6 +37,12 @@ public:
      */
     virtual std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>> &inputs, std::shared_ptr<Variable> &focus, std::shared_ptr<Tensor> &gradient) = 0;
 
+    /**
+     * @brief creates an independent copy of the operation, e.g. for a replica of the graph
+     * @note state that must differ between the copies (random generators, threads, caches) is created anew
+     */
+    virtual std::shared_ptr<Operation> clone() const = 0;
+
     /**
      * @brief sets the variable of the operation
      */
@@ -26,6 +26,7 @@ public:
     * @param gradient the sum of the gradients of the consumers
     */
     std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient) override;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<L1Norm>(*this); }
 };
 
 #endif // L1_NORM_HPP
\ No newline at end of file
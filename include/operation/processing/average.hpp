@@ -25,6 +25,7 @@ public:
      * @brief backward pass is not supported for average
      */
     std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient) override;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<Average>(*this); }
 };
 
 #endif // AVERAGE_HPP
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define DROP_OUT_HPP
 
 #include "../operation.hpp"
+#include "random.hpp"
 
 /**
  * @brief Dropout class, representing the dropout operation.
@@ -10,14 +11,17 @@ class Dropout : public Operation
 {
     double mDropoutRate;
     std::vector<bool> mMask;
+    std::mt19937 mGenerator; // draws the masks
     static bool msAveraging; // indicates if the dropout is in training or testing mode
 
 public:
-    Dropout(double dropoutRate) : mDropoutRate(dropoutRate) { mName = "DROPOUT"; }
+    Dropout(double dropoutRate) : mDropoutRate(dropoutRate), mGenerator(Random::generator(Random::Stream::DROPOUT)) { mName = "DROPOUT"; }
     void f(std::vector<std::shared_ptr<Variable>>& inputs) override;
     std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient) override;
+    [[nodiscard]] double getDropoutRate() const { return mDropoutRate; }
     static void activateAveraging() { msAveraging = true; }
     static void deactivateAveraging() { msAveraging = false; }
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<Dropout>(mDropoutRate); } // a new generator, so copies draw different masks
 };
 
 #endif // DROP_OUT_HPP
\ No newline at end of file
@@ -31,6 +31,7 @@ public:
      * @brief Backward pass is not supported for one hot encoding.
      */
     std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient)override;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<OneHot>(*this); }
 };
 
 #endif // ONEHOT_HPP
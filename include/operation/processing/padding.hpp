@@ -31,6 +31,7 @@ public:
      * @brief Remove padding from the gradient tensor.
      */
     virtual std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient)override;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<Padding>(*this); }
 };
 
 #endif // PADDING_HPP
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef PERMUTE_HPP
+#define PERMUTE_HPP
+
+#include "../operation.hpp"
+
+/**
+ * @brief the permute operation reorders the axes of the input tensor, e.g. to transpose a matrix or to convert NCHW to NHWC.
+ */
+class Permute : public Operation
+{
+    std::vector<size_t> mAxes; // axis i of the output is axis mAxes[i] of the input
+
+public:
+    /**
+     * @brief constructor for the permute operation
+     * @param axes the permutation of the axes, axis i of the output is axis axes[i] of the input
+     */
+    explicit Permute(const std::vector<size_t> &axes);
+    ~Permute() = default;
+
+    /**
+     * @brief permute the axes of the input tensor
+     */
+    void f(std::vector<std::shared_ptr<Variable>>& inputs) override;
+
+    /**
+     * @brief permute the gradient back with the inverse permutation
+     */
+    std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient) override;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<Permute>(*this); }
+};
+
+#endif // PERMUTE_HPP
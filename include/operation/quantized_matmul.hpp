@@ -0,0 +1,64 @@
+#ifndef QUANTIZED_MATMUL_HPP
+#define QUANTIZED_MATMUL_HPP
+
+#include "operation.hpp"
+
+/**
+ * @brief QuantizedMatmul class used for the inference of dense layers with int8 weights.
+ * It replaces the Matmul of a dense layer after training: the weights are quantized per output channel to int8,
+ * the inputs are quantized per tensor to unsigned 7 bit integers with a zero point, using the range seen during calibration.
+ * The products are accumulated in int32 (AVX-VNNI or AVX2 maddubs, with a scalar fallback that gives the same results)
+ * and converted back to Precision together with the bias in one pass over the result.
+ * The inputs use 7 instead of 8 bits, so the pairwise 16 bit sums of maddubs can never saturate.
+ * The right input (the float weights) is not read, the last column of the left input is expected to be the padding of ones,
+ * its row of the weights (the bias) is kept in float.
+ */
+class QuantizedMatmul : public Operation
+{
+    static constexpr std::int32_t msInputLevels = 127; // largest quantized input
+    static constexpr std::uint64_t msBlock = 32;        // the depth is padded to a multiple of the vector width
+
+    std::uint64_t mDepth = 0;        // k, the inputs without the padding
+    std::uint64_t mPaddedDepth = 0;  // k rounded up to msBlock
+    std::uint64_t mOutputs = 0;      // n
+    std::vector<std::int8_t> mWeights;     // n x mPaddedDepth, every output channel is contiguous
+    std::vector<std::int32_t> mColumnSums; // the sum of the quantized weights of every output channel, corrects the zero point
+    std::vector<float> mWeightScales;      // the scale of every output channel
+    std::vector<Precision> mBias;          // the last row of the weights
+    float mInputScale = 1;
+    std::int32_t mInputZeroPoint = 0;
+
+    /**
+     * @brief the int32 dot products of one quantized input row with four output channels
+     */
+    void dot(const std::uint8_t *input, std::uint64_t channel, std::int32_t *result) const;
+
+public:
+    /**
+     * @brief quantize the weights of a dense layer
+     * @param weights the (k + 1) x n weights, the last row is the bias
+     * @param inputMinimum the smallest input seen during calibration
+     * @param inputMaximum the largest input seen during calibration
+     */
+    QuantizedMatmul(const Tensor &weights, Precision inputMinimum, Precision inputMaximum);
+    ~QuantizedMatmul() = default;
+
+    /**
+     * @brief quantize the left input and multiply it with the quantized weights
+     * @param inputs the input variables, the padded input and the float weights
+     */
+    void f(std::vector<std::shared_ptr<Variable>>& inputs) override;
+
+    /**
+     * @brief quantized layers are inference only, calling this function throws
+     */
+    std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient) override;
+
+    /**
+     * @brief get the memory used by the quantized weights in bytes
+     */
+    [[nodiscard]] std::uint64_t bytes() const;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<QuantizedMatmul>(*this); }
+};
+
+#endif // QUANTIZED_MATMUL_HPP
@@ -0,0 +1,73 @@
+#ifndef SHARDED_MATMUL_HPP
+#define SHARDED_MATMUL_HPP
+
+#include "operation.hpp"
+#include "../datatypes/gemm.hpp"
+#include "../parallel.hpp"
+
+/**
+ * @brief ShardedMatmul class used for tensor parallel dense layers, the weights are split by output columns into shards.
+ * The inputs are the left matrix X followed by the weight shards W_0, ..., W_{S-1}, the result is [X W_0 | ... | X W_{S-1}].
+ * Every shard is owned by one member of a ThreadTeam: the member keeps its own copy of the weights (allocated and first
+ * touched by its pinned thread, so it stays in that core's cache and NUMA node), computes its columns of the result and
+ * in the backward pass the gradient of its weights and its part of the gradient of X. The parts of the gradient of X are
+ * summed in shard order, so the result does not depend on the timing of the threads.
+ * The copy is refreshed whenever the version of the weight variable changes, the variable keeps its tensor, so updates
+ * by the optimizer or by other workers (e.g. Hogwild!) are always seen. Every team claims its own cores.
+ */
+class ShardedMatmul : public Operation
+{
+    /**
+     * @brief a member's copy of its weight shard and the tensor and version it was copied from
+     */
+    struct LocalWeights
+    {
+        std::vector<Precision> values;
+        std::shared_ptr<Tensor> pSource = nullptr; // holding the tensor keeps a new tensor from reusing its address
+        std::uint64_t version = 0;
+    };
+
+    std::uint32_t mShards;
+    std::shared_ptr<ThreadTeam> mpTeam;                      // member s owns shard s
+    std::vector<LocalWeights> mLocalWeights;                 // the weights copied by their member
+    std::vector<std::vector<Precision>> mPartialResults;     // X W_s, later G_s W_s^T, of every member
+    std::vector<std::vector<Precision>> mGradientShards;     // the columns of the gradient that belong to a shard
+    std::vector<std::shared_ptr<Tensor>> mWeightGradients;   // the gradients of the shards of the last backward pass
+    std::shared_ptr<Tensor> mpInputGradient = nullptr;       // the gradient of X of the last backward pass
+    std::shared_ptr<Tensor> mpGradientSource = nullptr;      // the gradient the cached gradients were computed from
+
+    /**
+     * @brief get the first column of every shard in the result, and the number of columns as the last entry
+     */
+    static std::vector<std::uint64_t> offsets(std::vector<std::shared_ptr<Variable>> &inputs);
+
+    /**
+     * @brief compute the gradients of all shards and of X with one task for the team
+     */
+    void backward(std::vector<std::shared_ptr<Variable>> &inputs, const std::shared_ptr<Tensor> &gradient);
+
+public:
+    /**
+     * @brief constructor of the sharded matrix multiplication
+     * @param shards the number of weight shards, one thread per shard
+     */
+    explicit ShardedMatmul(std::uint32_t shards);
+    ~ShardedMatmul() = default;
+
+    /**
+     * @brief compute every shard's columns of the result on its own thread and gather them
+     * @param inputs the left matrix followed by the weight shards
+     */
+    void f(std::vector<std::shared_ptr<Variable>>& inputs) override;
+
+    /**
+     * @brief the gradients of all inputs are computed in the first call of a backward pass, later calls return them
+     * @param inputs the left matrix followed by the weight shards
+     * @param focus the variable to calculate the gradient for
+     * @param gradient the sum of the gradients of the consumers
+     */
+    std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient) override;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<ShardedMatmul>(mShards); } // a new team, the shards of the copy are owned by other threads
+};
+
+#endif // SHARDED_MATMUL_HPP
@@ -33,6 +33,7 @@ public:
     std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>> &inputs, std::shared_ptr<Variable> &focus, std::shared_ptr<Tensor> &gradient) override;
 
     void useWithExp();
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<CrossEntropy>(*this); }
 };
 
 #endif // CROSS_ENTROPY_HPP
\ No newline at end of file
@@ -26,6 +26,7 @@ public:
      * @return The gradient tensor.
     */
     std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient) override;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<MeanAbsoluteError>(*this); }
 };
 
 #endif // MEAN_ABSOLUTE_ERROR_HPP
\ No newline at end of file
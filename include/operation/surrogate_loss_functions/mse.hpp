@@ -24,6 +24,7 @@ public:
      * @return The gradient tensor.
     */
     std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient) override;
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<MSE>(*this); }
 };
 
 #endif // MSE_HPP
\ No newline at end of file
@@ -8,7 +8,7 @@
  */
 class HeInitialization : public UniformDistributionInitializer
 {
-    double generate() override;
+    Precision generate() override;
 public:
     /**
      * @brief Create a random engine to generate random values.
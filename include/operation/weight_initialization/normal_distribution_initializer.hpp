@@ -12,7 +12,7 @@ class NormalDistributionInitializer : public WeightInitializer
     double mStdDev;
     std::normal_distribution<double> mDist;
 
-    double generate() override;
+    Precision generate() override;
 
 public:
     /**
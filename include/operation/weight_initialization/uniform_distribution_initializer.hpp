@@ -14,7 +14,7 @@ protected:
     double mUpperBound;
     std::uniform_real_distribution<double> mDist;
 
-    double generate() override;
+    Precision generate() override;
 
 public:
     
@@ -2,6 +2,8 @@
 #define WEIGHT_INITIALIZER_HPP
 
 #include "../../dependencies.hpp"
+#include "config.hpp"
+#include "random.hpp"
 
 /**
  * @brief Base class to initialize a vector randomly.
@@ -10,23 +12,28 @@ class WeightInitializer
 {
 protected:
 
-    std::random_device mRd;
     std::mt19937 mGen;
     std::uint32_t mInputUnits;
     std::uint32_t mOutputUnits;
 
-    virtual double generate() = 0;
+    virtual Precision generate() = 0;
 
 public:
 
     virtual void createRandomEngine(std::uint32_t inputUnits, std::uint32_t outputUnits) = 0;
 
     /**
-     * @brief Generate a vector of random values.
+     * @brief Generate a vector of inputUnits * outputUnits random values.
+     * @return The vector of random values.
+     */
+    std::vector<Precision> createRandomVector();
+
+    /**
+     * @brief Generate a vector of random values, e.g. for a shard of a layer.
      * @param size The size of the vector.
      * @return The vector of random values.
      */
-    std::vector<double> createRandomVector();
+    std::vector<Precision> createRandomVector(std::uint64_t size);
 };
 
 #endif // WEIGHT_INITIALIZER_HPP
\ No newline at end of file
@@ -21,11 +21,12 @@ class WeightMatrixInitializer : public Operation
 	std::shared_ptr<WeightInitializer> mpWeightInitializer; // used to initialize the weight matrix
     double mBias; // the bias of used for the initialization
     std::uint32_t mM; // the number of columns in the weight matrix
+    std::uint32_t mOutputUnits; // the number of output units used to scale the initialization, differs from mM for shards of a layer
 
     void createWeightMatrix(std::uint32_t n, std::uint32_t m);
 public:
 
-    explicit WeightMatrixInitializer(const std::uint32_t &m, std::shared_ptr<WeightInitializer> weightInitializer = std::make_shared<NormalizedInitialization>(), const double bias = 0) : mpWeightInitializer(std::move(weightInitializer)), mBias(bias), mM(m)
+    explicit WeightMatrixInitializer(const std::uint32_t &m, std::shared_ptr<WeightInitializer> weightInitializer = std::make_shared<NormalizedInitialization>(), const double bias = 0, const std::uint32_t outputUnits = 0) : mpWeightInitializer(std::move(weightInitializer)), mBias(bias), mM(m), mOutputUnits(outputUnits == 0 ? m : outputUnits)
     {
         mName = "WeightMatrixInitializer";
     }
@@ -35,6 +36,7 @@ public:
   	std::shared_ptr<Tensor> bprop(std::vector<std::shared_ptr<Variable>> &inputs, std::shared_ptr<Variable> &focus, std::shared_ptr<Tensor> &gradient) override;
 
 
+    std::shared_ptr<Operation> clone() const override { return std::make_shared<WeightMatrixInitializer>(*this); }
 };
 
 #endif //WEIGHT_MATRIX_INITIALIZER_HPP
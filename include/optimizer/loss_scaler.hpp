@@ -0,0 +1,51 @@
+#ifndef LOSS_SCALER_HPP
+#define LOSS_SCALER_HPP
+
+#include "../dependencies.hpp"
+#include "../graph.hpp"
+
+/**
+ * @brief The LossScaler class implements dynamic loss scaling.
+ * The gradient of the loss is multiplied by the scale before the backward pass, so small gradients do not vanish in the
+ * activation gradients. Before the optimizer step the gradients of the parameters are checked:
+ * if one of them overflowed the step is skipped and the scale is reduced, otherwise the gradients are divided by the scale
+ * again. After growthInterval steps without overflow the scale is increased.
+ */
+class LossScaler
+{
+    double mScale;
+    double mGrowthFactor;
+    double mBackoffFactor;
+    std::uint32_t mGrowthInterval;
+    std::uint32_t mGoodSteps = 0;    // steps since the last change of the scale
+    std::uint64_t mSkippedSteps = 0;
+
+public:
+    /**
+     * @brief Constructs a new LossScaler object.
+     * @param initialScale The initial scale of the loss.
+     * @param growthFactor The factor the scale grows by after growthInterval steps without overflow.
+     * @param backoffFactor The factor the scale shrinks by after an overflow.
+     * @param growthInterval The number of steps without overflow before the scale grows.
+     */
+    explicit LossScaler(double initialScale = 65536, double growthFactor = 2, double backoffFactor = 0.5, std::uint32_t growthInterval = 2000);
+
+    /**
+     * @brief Returns the current scale, used as the initial value of the leaves in the backward pass.
+     */
+    [[nodiscard]] double scale() const;
+
+    /**
+     * @brief Checks the gradients of the parameters for overflow, divides them by the scale and adapts the scale.
+     * @param rLearnableParameters The learnable parameters.
+     * @return true if the gradients are finite and the optimizer step can be applied, false if the step has to be skipped.
+     */
+    bool unscale(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters);
+
+    /**
+     * @brief Returns the number of steps that were skipped because of an overflow.
+     */
+    [[nodiscard]] std::uint64_t skippedSteps() const;
+};
+
+#endif // LOSS_SCALER_HPP
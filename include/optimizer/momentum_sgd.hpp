@@ -26,7 +26,7 @@ public:
     ~Momentum() = default;
 
     /**
-     * @brief Initializes the optimizer.
+     * @brief Initializes the optimizer, only the first call has an effect.
      * @param rLearnableParameters The learnable parameters.
      */
     void init(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters);
@@ -36,6 +36,14 @@ public:
      * @param rLearnableParameters The learnable parameters.
      */
     void update(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters) override;
+
+    /**
+     * @brief Applies the gradients of one worker to the shared parameters, the velocity is shared by all workers as well.
+     * @note init must be called before the workers start.
+     * @param rLearnableParameters The learnable parameters.
+     * @param rGradients The gradients of the worker.
+     */
+    void updateShared(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters, const std::vector<std::shared_ptr<Tensor>> & rGradients) override;
 };
 
 #endif // MOMENTUM_SGD_HPP
\ No newline at end of file
@@ -18,6 +18,18 @@ public:
      * @param rLearnableParameters The learnable parameters.
      */
     virtual void update(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters) = 0;
+
+    /**
+     * @brief Applies the gradients of one worker directly to the parameters shared by all workers (Hogwild!).
+     * @details May be called by several threads at once. No locks are taken, every element is read and written with a relaxed
+     * atomic operation, so concurrent updates of the same element can overwrite each other.
+     * @param rLearnableParameters The learnable parameters.
+     * @param rGradients The gradients of the worker, in the same order, nullptr leaves a parameter unchanged.
+     */
+    virtual void updateShared(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters, const std::vector<std::shared_ptr<Tensor>> & rGradients)
+    {
+        throw std::invalid_argument("Optimizer::updateShared: The optimizer does not support asynchronous updates.");
+    }
 };
 
 #endif // OPTIMIZER_HPP
\ No newline at end of file
@@ -15,6 +15,11 @@ class SGD final : public Optimizer
     Precision mLastDecay;
     Precision mIteration = 0;
 
+    /**
+     * @brief Gets the learning rate of an iteration.
+     */
+    [[nodiscard]] Precision mLearningRate(Precision iteration) const;
+
 public:
     /**
      * @brief Constructs a new SGD object.
@@ -35,6 +40,14 @@ public:
      * @param rLearnableParameters The learnable parameters.
      */
     void update(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters) override;
+
+    /**
+     * @brief Applies the gradients of one worker to the shared parameters, elements with a zero gradient are not touched.
+     * Every call counts as one iteration of the learning rate decay.
+     * @param rLearnableParameters The learnable parameters.
+     * @param rGradients The gradients of the worker.
+     */
+    void updateShared(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters, const std::vector<std::shared_ptr<Tensor>> & rGradients) override;
 };
 
 #endif //SGD_HPP
\ No newline at end of file
@@ -0,0 +1,117 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include "dependencies.hpp"
+
+/**
+ * @brief The Parallel class splits loops of the compute kernels over threads.
+ */
+class Parallel
+{
+    static std::uint32_t msThreadCount; // number of threads used by the kernels, 0 means all hardware threads
+    static thread_local std::uint32_t msLocalThreadCount; // replaces msThreadCount for kernels started by the current thread, 0 for no replacement
+
+public:
+    static constexpr std::uint64_t msMinimumWork = 1 << 15; // work units a thread should get at least, smaller jobs use fewer threads
+
+    /**
+     * @brief get the number of threads the kernels may use
+     */
+    static std::uint32_t threadCount();
+
+    /**
+     * @brief set the number of threads the kernels may use
+     * @param threads the number of threads, 0 to use all hardware threads
+     */
+    static void setThreadCount(std::uint32_t threads);
+
+    /**
+     * @brief set the number of threads the kernels started by the calling thread may use, e.g. by a thread that works on
+     * one replica of a model while other threads work on the others
+     * @param threads the number of threads, 0 to use the number of the process again
+     */
+    static void setLocalThreadCount(std::uint32_t threads);
+
+    /**
+     * @brief run function(begin, end) on contiguous parts of [0, size) in parallel
+     * @param size the number of iterations
+     * @param work an estimate of the total work, used to decide how many threads are worth spawning
+     * @param function the function to execute for a part of the iterations
+     */
+    static void forRange(std::uint64_t size, std::uint64_t work, const std::function<void(std::uint64_t, std::uint64_t)> &function);
+
+    /**
+     * @brief run function(index) for every index in [0, count), the threads claim the next index from a shared counter,
+     * which balances items of very different cost
+     * @param count the number of items
+     * @param work an estimate of the total work, used to decide how many threads are worth spawning
+     * @param function the function to execute for one item
+     * @param maximumThreads an upper limit for the number of threads, 0 for no limit beyond threadCount()
+     */
+    static void forEach(std::uint64_t count, std::uint64_t work, const std::function<void(std::uint64_t)> &function, std::uint32_t maximumThreads = 0);
+};
+
+/**
+ * @brief The ThreadTeam class keeps a fixed group of threads alive. Member i always runs on the same thread, which is
+ * pinned to its own core on Linux, so data that member i allocates and touches first stays in that core's cache and
+ * on its NUMA node across calls.
+ */
+class ThreadTeam
+{
+    static std::atomic<std::uint32_t> msNextCore; // the first core of the next claim, see claimCores
+
+    std::vector<std::thread> mThreads;
+    std::mutex mMutex;
+    std::condition_variable mStart;
+    std::condition_variable mDone;
+    std::function<void(std::uint32_t)> mTask;
+    std::uint64_t mGeneration = 0; // incremented for every task
+    std::uint32_t mRunning = 0;    // members still working on the current task
+    bool mStop = false;
+    std::exception_ptr mpError = nullptr;
+
+    /**
+     * @brief the loop of a member's thread
+     */
+    void work(std::uint32_t member);
+
+public:
+    /**
+     * @brief start the threads, member i runs on the coresPerMember cores from firstCore + i * coresPerMember on, modulo the
+     * number of cores
+     * @param size the number of members
+     * @param coresPerMember the number of neighbouring cores a member may run on, e.g. for the threads its kernels start
+     * @param firstCore the core of the first member, e.g. from claimCores so that small teams do not share cores
+     */
+    explicit ThreadTeam(std::uint32_t size, std::uint32_t coresPerMember = 1, std::uint32_t firstCore = 0);
+
+    /**
+     * @brief reserve neighbouring cores for a team that does not span the whole machine, the claims go round the cores,
+     * so teams only share cores when more cores are claimed than exist
+     * @param count the number of cores
+     * @return the first core of the claim
+     */
+    static std::uint32_t claimCores(std::uint32_t count);
+
+    /**
+     * @brief get the number of cores every member gets when the cores are split evenly between the members, at least one
+     * @param size the number of members
+     */
+    static std::uint32_t coreShare(std::uint32_t size);
+    ~ThreadTeam();
+
+    ThreadTeam(const ThreadTeam &) = delete;
+    ThreadTeam &operator=(const ThreadTeam &) = delete;
+
+    /**
+     * @brief get the number of members
+     */
+    [[nodiscard]] std::uint32_t size() const;
+
+    /**
+     * @brief run task(member) on every member and wait until all are done, the first exception of a member is rethrown
+     */
+    void run(const std::function<void(std::uint32_t)> &task);
+};
+
+#endif // PARALLEL_HPP
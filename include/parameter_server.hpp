@@ -0,0 +1,105 @@
+#ifndef PARAMETER_SERVER_HPP
+#define PARAMETER_SERVER_HPP
+
+#include "graph.hpp"
+#include "module/dataset.hpp"
+#include "optimizer/optimizer_variant.hpp"
+
+/**
+ * @brief The ParameterServer class trains a model with several worker processes. The training process is the server: it
+ * owns the parameters and the optimizer. For every epoch it forks the workers, each one gets a copy of the graph, trains on
+ * every workers-th batch of the shuffled training set and is pinned to its own group of cores. A worker runs the forward and
+ * backward pass of a batch, pushes the gradients to the server over a Unix domain socket and waits for the weights after
+ * the update. The synchronization has bounded staleness: the server answers a worker only while it is at most a given
+ * number of batches ahead of the slowest worker, so the weights a gradient is computed with miss a bounded number of updates.
+ * @note Requires a POSIX system (fork, socketpair). A forked worker has only the thread that forked it, so graphs with
+ * tensor parallel (sharded) layers, whose threads would be missing, are rejected.
+ */
+class ParameterServer
+{
+    typedef std::shared_ptr<Variable> VariablePtr;
+
+    /**
+     * @brief the message a worker sends with the gradients of a batch
+     */
+    struct Push
+    {
+        std::uint32_t batch;
+        std::uint64_t version; // the number of updates the weights of the worker include
+        double loss;
+        double surrogateLoss;
+    };
+
+    std::uint32_t mWorkerCount;
+    std::uint32_t mStaleness;
+    std::uint32_t mCoresPerWorker;
+
+    double mWallSeconds = 0;     // time the epochs took
+    double mMissedUpdates = 0;   // updates the weights of a gradient did not include, summed over all updates
+    std::uint64_t mUpdates = 0;
+    std::uint64_t mExamples = 0;
+    std::uint64_t mBytes = 0;    // bytes sent and received by the server
+
+#if defined(__unix__)
+    /**
+     * @brief write all bytes to a socket
+     */
+    static void mSend(int socket, const void *pData, std::uint64_t bytes);
+
+    /**
+     * @brief read exactly the given number of bytes from a socket
+     * @return false if the other side closed the socket
+     */
+    static bool mReceive(int socket, void *pData, std::uint64_t bytes);
+
+    /**
+     * @brief the loop of a worker process, trains on batches worker, worker + workers, ...
+     */
+    void mWork(int socket, std::uint32_t worker, std::uint32_t batches, Dataset &dataset, std::uint32_t batchSize, std::vector<VariablePtr> graphInputs, std::vector<VariablePtr> learnableVariables, std::vector<VariablePtr> gradientVariables, const std::vector<VariablePtr> &lossVariables) const;
+#endif
+
+public:
+    /**
+     * @param workers the number of worker processes, every worker gets an equal share of the cores
+     * @param staleness the number of batches a worker may be ahead of the slowest worker, 0 lets all workers advance in lockstep
+     */
+    ParameterServer(std::uint32_t workers, std::uint32_t staleness);
+
+    /**
+     * @brief train on all batches of the shuffled training set
+     * @param dataset the dataset, its training set must be shuffled and in memory
+     * @param batchSize the size of the batches
+     * @param graphInputs the data and label variable of the dataset followed by the learnable variables
+     * @param learnableVariables the variables that are trained, their weights must exist
+     * @param gradientVariables the variables the backward pass starts from
+     * @param lossVariables the loss and surrogate loss variables
+     * @param optimizer the optimizer of the server
+     * @return the values of the loss variables for every batch, in the order of the training set
+     */
+    std::vector<std::vector<double>> epoch(Dataset &dataset, std::uint32_t batchSize, std::vector<VariablePtr> &graphInputs, const std::vector<VariablePtr> &learnableVariables, const std::vector<VariablePtr> &gradientVariables, const std::vector<VariablePtr> &lossVariables, OptimizerVariant &optimizer);
+
+    [[nodiscard]] std::uint32_t workerCount() const;
+    [[nodiscard]] std::uint32_t staleness() const;
+
+    /**
+     * @brief get the number of training examples processed per second since the last reset
+     */
+    [[nodiscard]] double examplesPerSecond() const;
+
+    /**
+     * @brief get the mean number of updates the weights of a gradient did not include, since the last reset
+     */
+    [[nodiscard]] double meanStaleness() const;
+
+    /**
+     * @brief get the number of bytes the server sent and received since the last reset
+     */
+    [[nodiscard]] std::uint64_t bytesTransferred() const;
+
+    /**
+     * @brief reset the statistics
+     */
+    void resetStatistics();
+};
+
+#endif // PARAMETER_SERVER_HPP
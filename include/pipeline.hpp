@@ -0,0 +1,128 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include "graph.hpp"
+#include "parallel.hpp"
+#include "module/module_variant.hpp"
+
+/**
+ * @brief The Pipeline class trains a sequential model pipeline parallel. Contiguous groups of layers form stages, every
+ * stage runs on its own thread of a ThreadTeam with an equal share of the cores, the loss belongs to the last stage. A batch is split into micro-batches
+ * of equal size, which flow through the stages in a 1F1B schedule: after a warm-up of forward passes every stage
+ * alternates between the forward pass of the next micro-batch and the backward pass of the oldest one, so at most
+ * stages - s micro-batches are in flight in stage s. The gradients of the micro-batches are accumulated and applied once per batch.
+ * @note Dropout layers must keep all units (rate 1), the masks of a layer are not stored per micro-batch.
+ */
+class Pipeline
+{
+    typedef std::shared_ptr<Variable> VariablePtr;
+
+    /**
+     * @brief the tensors sent from one stage to a neighbour, one slot per micro-batch
+     */
+    class Mailbox
+    {
+        std::mutex mMutex;
+        std::condition_variable mReady;
+        std::vector<std::shared_ptr<Tensor>> mItems;
+        bool mClosed = false;
+
+    public:
+        explicit Mailbox(std::uint32_t microBatches) : mItems(microBatches) {}
+
+        /**
+         * @brief deliver the tensor of a micro-batch
+         */
+        void put(std::uint32_t microBatch, const std::shared_ptr<Tensor> &tensor);
+
+        /**
+         * @brief wait for the tensor of a micro-batch
+         * @return the tensor, nullptr if the mailbox was closed because another stage failed
+         */
+        std::shared_ptr<Tensor> take(std::uint32_t microBatch);
+
+        /**
+         * @brief wake up and release all waiting stages
+         */
+        void close();
+    };
+
+    /**
+     * @brief the part of the graph a thread is responsible for
+     */
+    struct Stage
+    {
+        std::vector<std::shared_ptr<Module>> modules;
+        VariablePtr pSource;                  // the variable of the previous stage (or of the dataset) the stage reads
+        VariablePtr pOutput;                  // the variable sent to the next stage, nullptr for the last stage
+        std::vector<VariablePtr> variables;   // the variables computed by the stage in topological order
+        std::vector<VariablePtr> stashed;     // the variables whose data is kept per micro-batch for the backward pass
+        std::vector<VariablePtr> learnables;
+        std::vector<VariablePtr> leaves;      // the gradient variables of the stage, e.g. the surrogate loss and the norms
+    };
+
+    std::uint32_t mStageCount;
+    std::uint32_t mMicroBatches;
+    std::uint32_t mCoresPerStage; // the threads the kernels of a stage may use
+    ThreadTeam mTeam;
+    std::vector<VariablePtr> mPlaceholders; // replace the source of every stage during a step, so the stages share no variables
+    VariablePtr mpLabelPlaceholder;         // replaces the labels in the last stage
+
+    double mBusySeconds = 0; // time all stages spent computing
+    double mWallSeconds = 0; // time the steps took
+
+    /**
+     * @brief assign contiguous groups of layers to the stages, balancing the number of parameters
+     */
+    std::vector<Stage> mSplit(const std::vector<std::shared_ptr<Module>> &modules, const VariablePtr &pData) const;
+
+    /**
+     * @brief move all consumers of a variable to another variable, keeping the position in the inputs of the consumers
+     */
+    static void mRedirect(const VariablePtr &pFrom, const VariablePtr &pTo);
+
+    /**
+     * @brief copy the rows of one micro-batch out of a batch
+     */
+    static std::shared_ptr<Tensor> mSlice(Tensor &batch, std::uint32_t microBatches, std::uint32_t microBatch);
+
+public:
+    /**
+     * @brief create the threads of the stages
+     * @param stages the number of stages, at most the number of layers
+     * @param microBatches the number of micro-batches a batch is split into, the batch size must be a multiple of it
+     */
+    Pipeline(std::uint32_t stages, std::uint32_t microBatches);
+
+    /**
+     * @brief forward and backward pass of the loaded batch, afterwards the gradient table of the graph holds the gradients
+     * of the whole batch and the loss variables hold the mean loss of the micro-batches
+     * @param modules the modules of the model in sequential order
+     * @param graphInputs the data and label variable of the dataset followed by the learnable variables
+     * @param learnableVariables the variables the gradients are computed for, their weights must exist
+     * @param gradientVariables the variables the backward pass starts from
+     * @param lossVariables the loss and surrogate loss variables
+     * @param leafInitValue the initial gradient of the gradient variables for the whole batch
+     */
+    void step(const std::vector<std::shared_ptr<Module>> &modules, std::vector<VariablePtr> &graphInputs, const std::vector<VariablePtr> &learnableVariables, const std::vector<VariablePtr> &gradientVariables, const std::vector<VariablePtr> &lossVariables, double leafInitValue);
+
+    [[nodiscard]] std::uint32_t stageCount() const;
+    [[nodiscard]] std::uint32_t microBatchCount() const;
+
+    /**
+     * @brief get the share of the stage time spent waiting for neighbours since the last reset, (S - 1) / (M + S - 1) in an ideal pipeline
+     */
+    [[nodiscard]] double bubbleFraction() const;
+
+    /**
+     * @brief get the time the stages spent waiting since the last reset, summed over the stages
+     */
+    [[nodiscard]] double bubbleSeconds() const;
+
+    /**
+     * @brief reset the bubble statistics
+     */
+    void resetStatistics();
+};
+
+#endif // PIPELINE_HPP
@@ -6,15 +6,80 @@
 #define PREPROCESSING_HPP
 
 #include "datatypes/tensor.hpp"
+#include "datatypes/sample_storage.hpp"
+#include "random.hpp"
 
 class Preprocessing
 {
     typedef std::vector<std::vector<Precision>> dataType;
 public:
+    /**
+     * @brief per-feature statistics of a set of samples, collected with Welford's algorithm
+     */
+    struct Statistics
+    {
+        std::uint64_t count = 0;
+        std::vector<double> minimum;
+        std::vector<double> maximum;
+        std::vector<double> mean;
+        std::vector<double> m2;         // the sum of the squared differences from the mean
+
+        explicit Statistics(std::uint64_t width = 0);
+
+        /**
+         * @brief add one sample
+         */
+        void add(const Precision *pValues);
+
+        /**
+         * @brief combine the statistics of another set of samples with the same width
+         */
+        void merge(const Statistics &other);
+
+        /**
+         * @brief get the population standard deviation per feature
+         */
+        [[nodiscard]] std::vector<double> standardDeviation() const;
+
+        /**
+         * @brief get the smallest and the largest value of all features
+         */
+        [[nodiscard]] double smallest() const;
+        [[nodiscard]] double largest() const;
+    };
+
+    /**
+     * @brief collect the statistics of the stored values in one parallel pass, the transformation is not applied.
+     * The rows are split into blocks that do not depend on the number of threads, so the result does not either.
+     */
+    static Statistics statistics(const SampleStorage &samples);
+    static Statistics statistics(const dataType &data);
+
+    /**
+     * @brief transform the samples in place and in parallel, value * scale + offset
+     * @param scale one value or one value per feature
+     * @param offset one value or one value per feature
+     */
+    static void transform(dataType &data, const std::vector<Precision> &scale, const std::vector<Precision> &offset);
+
     static void createBatch(const dataType &data, const dataType &labels, const std::uint32_t &batchSize, dataType &dataBatch, dataType &labelBatch);
     static void addNoise(dataType &data, const double &mean, const double &stddev);
     static dataType normalize(dataType const & input);
     static void splitData(dataType const & input, dataType const & target, double const & ratio, dataType & trainInput, dataType & validationInput, dataType & trainTarget, dataType & validationTarget);
+
+    /**
+     * @brief randomly split the indices [0, size) into a training and a validation part, the split used by splitData
+     * @param size the number of samples
+     * @param ratio the share of the samples used for training
+     * @param trainIndices the indices of the training samples
+     * @param validationIndices the indices of the validation samples
+     */
+    static void splitIndices(std::uint32_t size, double ratio, std::vector<std::uint32_t> & trainIndices, std::vector<std::uint32_t> & validationIndices);
+
+    /**
+     * @brief randomly split the indices [0, size) with the given generator instead of a new generator of the split stream
+     */
+    static void splitIndices(std::uint32_t size, double ratio, std::vector<std::uint32_t> & trainIndices, std::vector<std::uint32_t> & validationIndices, std::mt19937 generator);
 };
 
 #endif //PREPROCESSING_HPP
@@ -0,0 +1,59 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include "dependencies.hpp"
+
+/**
+ * @brief The Random class hands out the random number generators of the framework.
+ * Every purpose has its own stream, so e.g. enabling dropout does not change the initial weights.
+ * In deterministic mode the generators are seeded from the seed, the stream and the number of generators the stream
+ * has handed out before, so two runs that build the same model in the same order draw the same numbers.
+ * Otherwise every generator is seeded from std::random_device.
+ * @note Together with the fixed summation orders of the kernels (Reduction, Gemm, SparseMatrix), a deterministic run
+ * produces bitwise identical weights independent of the number of threads.
+ */
+class Random
+{
+public:
+    enum class Stream
+    {
+        INITIALIZATION, // weight initializers
+        DROPOUT,        // dropout masks
+        SHUFFLE,        // order of the training examples
+        SPLIT,          // split into training and validation data
+        NOISE,          // noise added to the data
+        COUNT
+    };
+
+private:
+    static bool msDeterministic;
+    static std::uint64_t msSeed;
+    static std::array<std::uint64_t, static_cast<size_t>(Stream::COUNT)> msGenerators; // generators handed out per stream
+    static std::mutex msMutex;
+
+public:
+    /**
+     * @brief seed all streams and enable the deterministic mode, call it before the model is built
+     * @param seed the seed
+     */
+    static void setSeed(std::uint64_t seed);
+
+    /**
+     * @brief enable or disable the deterministic mode, enabling restarts all streams
+     */
+    static void setDeterministic(bool deterministic);
+
+    /**
+     * @brief check if the deterministic mode is enabled
+     */
+    static bool isDeterministic();
+
+    /**
+     * @brief get a new generator of a stream
+     * @param stream the purpose of the random numbers
+     * @return the generator
+     */
+    static std::mt19937 generator(Stream stream);
+};
+
+#endif // RANDOM_HPP
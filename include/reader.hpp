@@ -6,6 +6,8 @@
 #define READER_HPP
 
 #include <datatypes/tensor.hpp>
+#include <datatypes/sample_storage.hpp>
+#include <datatypes/mapped_file.hpp>
 
 #include "dependencies.hpp"
 
@@ -13,8 +15,66 @@ class Reader
 {
 public:
     typedef std::vector<std::vector<Precision>> data_type;
-    static void read_bin(data_type const & designMatrix, data_type const & label, const std::string &path);
+
+    /**
+     * @brief the order of the values of an image
+     */
+    enum class image_layout
+    {
+        NCHW, // one plane per channel
+        NHWC  // the channels of a pixel are adjacent
+    };
     static data_type read_idx(const std::string& path);
+
+    /**
+     * @brief the layout of an IDX file
+     */
+    struct idx_header
+    {
+        SampleStorage::Type type;
+        std::vector<size_t> shape;
+        size_t width;  // the number of values per sample, the product of all dimensions but the first
+        size_t offset; // the position of the first value in the file
+    };
+
+    /**
+     * @brief validate and decode the header of an IDX file
+     * @param pFile the beginning of the file
+     * @param length the number of bytes available at pFile, at least the header
+     */
+    static idx_header read_idx_header(const std::byte *pFile, size_t length);
+
+    /**
+     * @brief map an IDX file of any element type into memory, the values are neither copied nor widened but converted when
+     * the rows of a batch are copied, the first dimension indexes the samples
+     * @param path the path of the file
+     * @return a view of the samples in the mapped file, one row per sample
+     */
+    static SampleStorage read_idx_samples(const std::string& path);
+
+    /**
+     * @brief read CIFAR-10 or CIFAR-100 batch files, every record is the label followed by the 3x32x32 pixels
+     * @param paths the batch files, e.g. data_batch_1.bin to data_batch_5.bin, their images are concatenated
+     * @param images the pixels as bytes, one row per image in the requested layout
+     * @param labels the class of every image
+     * @param cifar100 the records start with a coarse and a fine label
+     * @param layout the order of the pixels, the files store NCHW
+     * @param fineLabels use the fine labels (100 classes) of CIFAR-100 instead of the coarse ones (20 classes)
+     */
+    static void read_cifar(const std::vector<std::string>& paths, SampleStorage& images, SampleStorage& labels, bool cifar100 = false, image_layout layout = image_layout::NCHW, bool fineLabels = true);
+
+    /**
+     * @brief read a CSV or TSV file of numbers in parallel, the mapped file is split into chunks at line boundaries and every
+     * thread parses its chunks directly into the rows of the result, fields can not be quoted
+     * @param path the path of the file
+     * @param samples the feature columns, one row per non-empty line
+     * @param labels the label columns, one row per non-empty line
+     * @param labelColumns the positions of the label columns, counted from 0
+     * @param featureColumns the positions of the feature columns in the order they are stored, empty for all columns that are no labels
+     * @param delimiter the separator of the fields, e.g. ',' or '\t'
+     * @param header the first line contains the names of the columns
+     */
+    static void read_csv(const std::string& path, SampleStorage& samples, SampleStorage& labels, const std::vector<size_t>& labelColumns, const std::vector<size_t>& featureColumns = {}, char delimiter = ',', bool header = false);
 };
 
 #endif //READER_HPP
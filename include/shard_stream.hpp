@@ -0,0 +1,145 @@
+#ifndef SHARD_STREAM_HPP
+#define SHARD_STREAM_HPP
+
+#include "random.hpp"
+#include "datatypes/sample_storage.hpp"
+
+/**
+ * @brief The ShardStream class streams a training set that does not fit into memory from shards on disk. A shard is a
+ * pair of IDX files, the samples and their labels, all shards have the same element types and widths.
+ * The shards are split into chunks of consecutive rows and every epoch reads all chunks once in a new random order.
+ * A pool of reader threads reads the chunks ahead with pread, in the order they are consumed, as long as they fit into
+ * the read-ahead part of the memory budget. The rows of the chunks pass through a shuffle buffer that takes the other
+ * part of the budget: every row of a batch is drawn at random from the buffer and its slot is refilled with the next
+ * row of the stream, so the rows of a chunk are spread over the epoch. The order only depends on the generator, not on
+ * the timing of the readers. The rows are stored in their native type and converted when a batch is assembled.
+ */
+class ShardStream
+{
+    struct Chunk
+    {
+        std::uint32_t shard;
+        std::uint64_t first;                // the first row of the chunk in the shard
+        std::uint64_t rows;
+    };
+
+    struct Shard
+    {
+        std::string samples;
+        std::string labels;
+        std::uint64_t samplesOffset;        // the position of the first value in the files
+        std::uint64_t labelsOffset;
+    };
+
+    std::vector<Shard> mShards;
+    std::vector<Chunk> mChunks;
+    SampleStorage::Type mSampleType = SampleStorage::Type::UINT8;
+    SampleStorage::Type mLabelType = SampleStorage::Type::UINT8;
+    std::uint64_t mWidth = 0;
+    std::uint64_t mLabelWidth = 0;
+    std::uint64_t mSampleBytes = 0;        // the bytes of a row of samples
+    std::uint64_t mLabelBytes = 0;         // the bytes of a row of labels
+    std::uint64_t mSize = 0;               // the number of rows of all shards
+    std::uint64_t mReadBudget = 0;         // the bytes of the chunks that may be read ahead
+    std::uint32_t mReaderCount;
+    std::mt19937 mGenerator = Random::generator(Random::Stream::SHUFFLE);
+
+    // the shuffle buffer, rows are kept as they are stored in the files
+    std::uint64_t mPoolRows = 0;
+    std::shared_ptr<std::vector<std::byte>> mpPoolSamples;
+    std::shared_ptr<std::vector<std::byte>> mpPoolLabels;
+    SampleStorage mPoolSampleView;         // converts the rows of the buffer
+    SampleStorage mPoolLabelView;
+    std::uint64_t mPoolFill = 0;
+
+    // the chunks of the current epoch in the order they are consumed
+    std::vector<std::uint32_t> mOrder;
+    std::vector<std::vector<std::byte>> mSamples; // the samples of a chunk once it is read
+    std::vector<std::vector<std::byte>> mLabels;
+    std::vector<char> mLoaded;
+
+    std::mutex mMutex;
+    std::condition_variable mChanged;
+    std::vector<std::thread> mReaders;
+    std::uint64_t mClaimed = 0;            // the number of chunks of the order handed to a reader
+    std::uint64_t mReserved = 0;           // the bytes of the chunks handed to a reader and not yet consumed
+    bool mStop = false;
+    std::exception_ptr mpError = nullptr;  // the exception of a reader, rethrown by next
+
+    std::uint64_t mCurrent = 0;            // the chunk the shuffle buffer is refilled from
+    std::uint64_t mCurrentRow = 0;         // the next row of the chunk
+    std::uint64_t mPosition = 0;           // the number of rows returned in the epoch
+    bool mRunning = false;
+
+    std::atomic<std::uint64_t> mBytesRead = 0;
+
+    /**
+     * @brief read bytes of a file at an offset
+     */
+    static void mRead(const std::string &path, std::uint64_t offset, std::uint64_t bytes, std::byte *pDestination);
+
+    /**
+     * @brief the loop of a reader thread
+     */
+    void mReadAhead();
+
+    /**
+     * @brief refill the shuffle buffer from the chunks, waiting for the readers if necessary
+     */
+    void mFill();
+
+    [[nodiscard]] std::uint64_t mChunkBytes(std::uint64_t position) const;
+
+public:
+    /**
+     * @brief read the headers of the shards and split them into chunks
+     * @param shards the paths of the sample and the label file of every shard
+     * @param memoryBudget the bytes the stream may hold, half of them for the shuffle buffer and half for reading ahead
+     * @param readers the number of reader threads
+     */
+    ShardStream(const std::vector<std::pair<std::string, std::string>> &shards, std::uint64_t memoryBudget, std::uint32_t readers = 2);
+    ~ShardStream();
+
+    ShardStream(const ShardStream &) = delete;
+    ShardStream &operator=(const ShardStream &) = delete;
+
+    /**
+     * @brief start a new epoch in a new order
+     */
+    void start();
+
+    /**
+     * @brief stop the readers
+     */
+    void stop();
+
+    /**
+     * @brief copy the next rows of the epoch into the tensors, reusing tensors nobody else holds
+     * @param batchSize the number of rows
+     * @param data the samples of the batch
+     * @param labels the labels of the batch
+     */
+    void next(std::uint32_t batchSize, std::shared_ptr<Tensor> &data, std::shared_ptr<Tensor> &labels);
+
+    /**
+     * @brief set the transformation of the samples, see SampleStorage::setTransformation
+     */
+    void setTransformation(const std::vector<Precision> &scale, const std::vector<Precision> &offset);
+
+    /**
+     * @brief get the number of rows of all shards
+     */
+    [[nodiscard]] std::uint64_t size() const;
+
+    /**
+     * @brief get the number of rows returned in the current epoch
+     */
+    [[nodiscard]] std::uint64_t position() const;
+
+    /**
+     * @brief get the number of bytes read from the shards
+     */
+    [[nodiscard]] std::uint64_t bytesRead() const;
+};
+
+#endif // SHARD_STREAM_HPP
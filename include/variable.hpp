@@ -18,6 +18,7 @@ class Variable
     static std::uint32_t msCounter;                             // keep track of the number of variables created
     std::uint32_t mId;                                          // the unique id of the variable
     std::string mOperationName;                                 // the name of the operation that calculates the data
+    std::uint64_t mVersion = 0;                                 // incremented whenever the data changes, see bumpVersion
 
 public:
     /**
@@ -67,6 +68,18 @@ public:
      */
     void setData(const std::shared_ptr<Tensor> &data);
 
+    /**
+     * @brief This function returns the version of the data. Caches derived from the data (e.g. packed weights) are valid as long as the version does not change.
+     * @return std::uint64_t The version of the data.
+     */
+    [[nodiscard]] std::uint64_t getVersion() const;
+
+    /**
+     * @brief This function marks the data as changed. It is called by setData, by the graph after the operation computed
+     * the data and by the optimizers after they updated a parameter. Code that writes into the data directly has to call it as well.
+     */
+    void bumpVersion();
+
     /**
      * @brief This function returns the id of the variable.
      * @return std::uint32_t The id of the variable.
@@ -123,18 +123,9 @@ namespace JSON
         }
         auto trainingParams = std::get<std::vector<JsonNode>>(std::get<JsonNode>(child.m_children["train"]).m_children["parameters"]);
 
-        // mnist dataset is only dataset supported
-        typedef std::vector<std::vector<Precision>> dataType;
-        dataType train_input = Reader::read_idx("../data/mnist/train-images.idx3-ubyte");
-        dataType train_target = Reader::read_idx("../data/mnist/train-labels.idx1-ubyte");
-
-        dataType test_input = Reader::read_idx("../data/mnist/t10k-images.idx3-ubyte");
-        dataType test_target = Reader::read_idx("../data/mnist/t10k-labels.idx1-ubyte");
-
-        train_input = Preprocessing::normalize(train_input);
-        test_input = Preprocessing::normalize(test_input);
-
-        Dataset mnist(train_input, train_target, 0.99, test_input, test_target);
+        // mnist dataset is only dataset supported, it is split and normalized once and mapped from the cache afterwards
+        Dataset mnist = DatasetCache("../data/cache").loadIdx("../data/mnist/train-images.idx3-ubyte", "../data/mnist/train-labels.idx1-ubyte",
+            "../data/mnist/t10k-images.idx3-ubyte", "../data/mnist/t10k-labels.idx1-ubyte", 0.99, true);
 
 
         model.train(mnist, std::get<std::string>(trainingParams[0].m_children["value"]), std::get<std::string>(trainingParams[1].m_children["value"]),
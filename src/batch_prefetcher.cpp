@@ -0,0 +1,113 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "batch_prefetcher.hpp"
+
+BatchPrefetcher::BatchPrefetcher(const std::uint32_t depth) : mSlots(depth + 1), mDepth(depth)
+{
+    if (depth == 0)
+    {
+        throw std::invalid_argument("BatchPrefetcher::BatchPrefetcher: At least one batch must be assembled ahead.");
+    }
+}
+
+BatchPrefetcher::~BatchPrefetcher()
+{
+    stop();
+}
+
+void BatchPrefetcher::mProduce(const Gather &gather, std::uint32_t first, const std::uint32_t end)
+{
+    try
+    {
+        for (std::uint64_t batch = 0; first + mBatchSize <= end; batch++, first += mBatchSize)
+        {
+            // the slot is free once the consumer took the batch after the one it held
+            for (std::uint64_t consumed = mConsumed.load(std::memory_order_acquire); batch - consumed >= mDepth; consumed = mConsumed.load(std::memory_order_acquire))
+            {
+                if (mStop.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+                mConsumed.wait(consumed, std::memory_order_acquire);
+            }
+            if (mStop.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+            Slot &slot = mSlots[batch % mSlots.size()];
+            // the graph can still hold the tensors of an old batch for a moment, they are only overwritten if nobody else does
+            if (slot.pData != nullptr && slot.pData.use_count() > 1)
+            {
+                slot.pData = nullptr;
+            }
+            if (slot.pLabels != nullptr && slot.pLabels.use_count() > 1)
+            {
+                slot.pLabels = nullptr;
+            }
+            std::atomic_thread_fence(std::memory_order_acquire); // the last reader released the tensors before we write them
+            gather(first, slot.pData, slot.pLabels);
+            mProduced.store(batch + 1, std::memory_order_release);
+            mProduced.notify_one();
+        }
+    }
+    catch (...)
+    {
+        mpError = std::current_exception();
+        mProduced.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_release); // wake the consumer
+        mProduced.notify_one();
+    }
+}
+
+void BatchPrefetcher::start(const Gather &gather, const std::uint32_t first, const std::uint32_t batchSize, const std::uint32_t end)
+{
+    stop();
+    mStop.store(false, std::memory_order_relaxed);
+    mProduced.store(0, std::memory_order_relaxed);
+    mConsumed.store(0, std::memory_order_relaxed);
+    mpError = nullptr;
+    mNext = first;
+    mBatchSize = batchSize;
+    mRunning = true;
+    mThread = std::thread(&BatchPrefetcher::mProduce, this, gather, first, end);
+}
+
+void BatchPrefetcher::stop()
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    mStop.store(true, std::memory_order_relaxed);
+    mConsumed.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_release); // wake the producer if the ring is full
+    mConsumed.notify_one();
+    mThread.join();
+    mRunning = false;
+}
+
+bool BatchPrefetcher::ready(const std::uint32_t first, const std::uint32_t batchSize) const
+{
+    return mRunning && mNext == first && mBatchSize == batchSize;
+}
+
+void BatchPrefetcher::take(std::shared_ptr<Tensor> &data, std::shared_ptr<Tensor> &labels)
+{
+    const std::uint64_t batch = mConsumed.load(std::memory_order_relaxed);
+    for (std::uint64_t produced = mProduced.load(std::memory_order_acquire); produced <= batch; produced = mProduced.load(std::memory_order_acquire))
+    {
+        mProduced.wait(produced, std::memory_order_acquire);
+    }
+    if (mpError != nullptr)
+    {
+        const std::exception_ptr pError = mpError;
+        stop();
+        std::rethrow_exception(pError);
+    }
+    const Slot &slot = mSlots[batch % mSlots.size()];
+    data = slot.pData;
+    labels = slot.pLabels;
+    mNext += mBatchSize;
+    mConsumed.store(batch + 1, std::memory_order_release);
+    mConsumed.notify_one();
+}
@@ -0,0 +1,150 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "data_parallel.hpp"
+
+DataParallel::DataParallel(const std::uint32_t replicas) :
+mReplicaCount(replicas),
+mCoresPerReplica(ThreadTeam::coreShare(replicas)),
+mTeam(replicas, mCoresPerReplica)
+{
+}
+
+void DataParallel::mReduce(std::vector<std::shared_ptr<Tensor>> &parts)
+{
+    for (size_t distance = 1; distance < parts.size(); distance *= 2)
+    {
+        for (size_t r = 0; r + distance < parts.size(); r += 2 * distance)
+        {
+            Precision *pSum = parts[r]->data();
+            const Precision *pPart = parts[r + distance]->data();
+            for (std::uint32_t i = 0; i < parts[r]->capacity(); i++)
+            {
+                pSum[i] += pPart[i];
+            }
+        }
+    }
+}
+
+std::shared_ptr<Tensor> DataParallel::mSlice(Tensor &batch, const std::uint64_t begin, const std::uint64_t end)
+{
+    std::vector<size_t> shape = batch.shape();
+    const std::uint64_t rowSize = batch.capacity() / shape[0];
+    shape[0] = end - begin;
+    std::shared_ptr<Tensor> part = std::make_shared<Tensor>(Tensor(shape));
+    std::copy_n(batch.data() + begin * rowSize, part->capacity(), part->data());
+    return part;
+}
+
+void DataParallel::step(std::vector<VariablePtr> &graphInputs, const std::vector<VariablePtr> &learnableVariables, const std::vector<VariablePtr> &gradientVariables, const std::vector<VariablePtr> &lossVariables, const double leafInitValue)
+{
+    if (mModelLearnables != learnableVariables)
+    {
+        mReplicas.clear();
+        for (std::uint32_t r = 0; r < mReplicaCount; r++)
+        {
+            mReplicas.emplace_back(graphInputs, learnableVariables, gradientVariables, lossVariables);
+        }
+        mModelLearnables = learnableVariables;
+    }
+
+    Tensor &data = *graphInputs[0]->getData();
+    Tensor &labels = *graphInputs[1]->getData();
+    const std::uint64_t rows = data.shape(0);
+    if (rows < mReplicaCount)
+    {
+        throw std::invalid_argument("DataParallel::step: The batch has fewer rows than there are replicas.");
+    }
+
+    const std::uint32_t replicaCount = mReplicaCount;
+    const size_t buckets = learnableVariables.size();
+    std::vector<std::vector<std::shared_ptr<Tensor>>> parts(buckets, std::vector<std::shared_ptr<Tensor>>(replicaCount));
+    std::vector<std::atomic<std::uint32_t>> finished(buckets);
+    std::vector<std::vector<double>> losses(replicaCount, std::vector<double>(lossVariables.size(), 0));
+    std::vector<double> computeSeconds(replicaCount, 0);
+    std::vector<double> reduceSeconds(replicaCount, 0);
+
+    const auto start = std::chrono::steady_clock::now();
+    mTeam.run([&](const std::uint32_t r) {
+        GraphReplica &replica = mReplicas[r];
+        Parallel::setLocalThreadCount(mCoresPerReplica);
+        const auto begin = std::chrono::steady_clock::now();
+
+        replica.share(learnableVariables); // hand over parameters that changed since the last step
+        const std::uint64_t first = r * rows / replicaCount;
+        const std::uint64_t last = (r + 1) * rows / replicaCount;
+        replica.pData->setData(mSlice(data, first, last));
+        replica.pLabels->setData(mSlice(labels, first, last));
+        Graph::execute(replica.variables);
+        for (size_t k = 0; k < replica.losses.size(); k++)
+        {
+            losses[r][k] = replica.losses[k]->getData()->at(0);
+        }
+
+        Graph::GradTable gradTable;
+        Graph::seedLeaves(gradTable, replica.leaves, replica.losses, leafInitValue, replicaCount);
+        double reducing = 0;
+        for (size_t k = buckets; k > 0; k--) // the parameters close to the loss are ready first
+        {
+            parts[k - 1][r] = std::make_shared<Tensor>(*Graph::computeGradients({replica.learnables[k - 1]}, gradTable)[0]);
+            if (finished[k - 1].fetch_add(1, std::memory_order_acq_rel) + 1 == replicaCount) // the last replica of the bucket sums it
+            {
+                const auto reduceBegin = std::chrono::steady_clock::now();
+                mReduce(parts[k - 1]);
+                reducing += std::chrono::duration<double>(std::chrono::steady_clock::now() - reduceBegin).count();
+            }
+        }
+        reduceSeconds[r] = reducing;
+        computeSeconds[r] = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() - reducing;
+    });
+    mWallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    mComputeSeconds += std::accumulate(computeSeconds.begin(), computeSeconds.end(), 0.0);
+    mReduceSeconds += std::accumulate(reduceSeconds.begin(), reduceSeconds.end(), 0.0);
+    mExamples += rows;
+
+    std::vector<std::shared_ptr<Tensor>> gradients;
+    for (size_t k = 0; k < buckets; k++)
+    {
+        gradients.push_back(parts[k][0]);
+    }
+    GRAPH->setGradients(learnableVariables, gradients);
+
+    for (size_t k = 0; k < lossVariables.size(); k++) // the losses are means over the rows of a shard
+    {
+        double sum = 0;
+        for (std::uint32_t r = 0; r < replicaCount; r++)
+        {
+            sum += losses[r][k] * static_cast<double>((r + 1) * rows / replicaCount - r * rows / replicaCount);
+        }
+        lossVariables[k]->setData(std::make_shared<Tensor>(Tensor({1}, sum / static_cast<double>(rows))));
+    }
+}
+
+std::uint32_t DataParallel::replicaCount() const
+{
+    return mReplicaCount;
+}
+
+double DataParallel::examplesPerSecond() const
+{
+    return mWallSeconds == 0 ? 0 : static_cast<double>(mExamples) / mWallSeconds;
+}
+
+double DataParallel::efficiency() const
+{
+    return mWallSeconds == 0 ? 0 : mComputeSeconds / (mReplicaCount * mWallSeconds);
+}
+
+double DataParallel::reduceSeconds() const
+{
+    return mReduceSeconds;
+}
+
+void DataParallel::resetStatistics()
+{
+    mComputeSeconds = 0;
+    mReduceSeconds = 0;
+    mWallSeconds = 0;
+    mExamples = 0;
+}
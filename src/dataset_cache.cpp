@@ -0,0 +1,224 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "dataset_cache.hpp"
+#include "reader.hpp"
+
+#include <cstring>
+#include <iomanip>
+
+DatasetCache::DatasetCache(const std::string &directory) : mDirectory(directory)
+{
+}
+
+std::uint64_t DatasetCache::mHash(const std::byte *pBytes, const std::uint64_t size, const std::uint64_t seed)
+{
+    auto mix = [](std::uint64_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 33;
+        return hash;
+    };
+    std::uint64_t hash = mix(seed ^ size);
+    std::uint64_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, pBytes + i, 8);
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    }
+    std::uint64_t tail = 0;
+    if (i < size)
+    {
+        std::memcpy(&tail, pBytes + i, size - i);
+    }
+    return mix(hash ^ tail);
+}
+
+void DatasetCache::mWrite(const std::filesystem::path &path, const std::uint64_t key, const std::array<const SampleStorage *, 6> &sets)
+{
+    auto align = [](const std::uint64_t position) { return (position + 63) / 64 * 64; };
+
+    std::array<Section, 6> sections;
+    std::memset(sections.data(), 0, sizeof(sections)); // no undefined padding bytes in the file
+    std::uint64_t position = sizeof(Header) + sizeof(sections);
+    for (size_t s = 0; s < sets.size(); s++)
+    {
+        const SampleStorage &set = *sets[s];
+        sections[s].width = set.width();
+        sections[s].count = set.size() * set.width();
+        sections[s].type = set.type();
+        sections[s].bigEndian = set.bigEndian();
+        if (!set.scale().empty())
+        {
+            position = align(position);
+            sections[s].transformation = position;
+            position += 2 * set.width() * sizeof(Precision);
+        }
+        position = align(position);
+        sections[s].values = position;
+        position += set.bytes();
+    }
+    Header header{msMagic, msVersion, sizeof(Precision), key, position};
+
+    std::filesystem::create_directories(path.parent_path());
+    const std::filesystem::path temporary = path.string() + "." + std::to_string(std::random_device{}()) + ".tmp";
+    std::ofstream file(temporary, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("DatasetCache::mWrite: Could not create " + temporary.string());
+    }
+    std::uint64_t written = 0;
+    auto write = [&](const void *pBytes, const std::uint64_t size, const std::uint64_t at) {
+        const std::vector<char> padding(at - written, 0);
+        file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        file.write(static_cast<const char *>(pBytes), static_cast<std::streamsize>(size));
+        written = at + size;
+    };
+    write(&header, sizeof(header), 0);
+    write(sections.data(), sizeof(sections), sizeof(header));
+    for (size_t s = 0; s < sets.size(); s++)
+    {
+        const SampleStorage &set = *sets[s];
+        if (sections[s].transformation != 0)
+        {
+            write(set.scale().data(), set.width() * sizeof(Precision), sections[s].transformation);
+            write(set.offset().data(), set.width() * sizeof(Precision), sections[s].transformation + set.width() * sizeof(Precision));
+        }
+        const std::uint64_t rowBytes = set.width() * SampleStorage::elementSize(set.type());
+        for (std::uint64_t r = 0; r < set.size(); r++) // the sets select their rows from the input files
+        {
+            write(set.rawRow(r), rowBytes, sections[s].values + r * rowBytes);
+        }
+    }
+    file.close();
+    if (!file)
+    {
+        std::filesystem::remove(temporary);
+        throw std::runtime_error("DatasetCache::mWrite: Could not write " + temporary.string());
+    }
+    std::filesystem::rename(temporary, path); // atomic, readers see the old state or the whole file
+}
+
+bool DatasetCache::mRead(const std::filesystem::path &path, const std::uint64_t key, std::array<SampleStorage, 6> &sets)
+{
+    if (!std::filesystem::exists(path))
+    {
+        return false;
+    }
+    std::shared_ptr<const MappedFile> file;
+    try
+    {
+        file = std::make_shared<const MappedFile>(path.string());
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+
+    Header header;
+    std::array<Section, 6> sections;
+    if (file->size() < sizeof(header) + sizeof(sections))
+    {
+        return false;
+    }
+    std::memcpy(&header, file->data(), sizeof(header));
+    std::memcpy(sections.data(), file->data() + sizeof(header), sizeof(sections));
+    if (header.magic != msMagic || header.version != msVersion || header.precisionBytes != sizeof(Precision) || header.key != key || header.size != file->size())
+    {
+        return false;
+    }
+
+    for (size_t s = 0; s < sets.size(); s++)
+    {
+        const Section &section = sections[s];
+        if (section.type > SampleStorage::Type::FLOAT64 || (section.width == 0 ? section.count != 0 : section.count % section.width != 0) ||
+            section.values + section.count * SampleStorage::elementSize(section.type) > file->size() ||
+            section.transformation + 2 * section.width * sizeof(Precision) > file->size())
+        {
+            return false;
+        }
+        sets[s] = SampleStorage(file, file->data() + section.values, section.type, section.bigEndian, section.count, section.width); // the values stay in the mapping
+        if (section.transformation != 0)
+        {
+            std::vector<Precision> scale(section.width);
+            std::vector<Precision> offset(section.width);
+            std::memcpy(scale.data(), file->data() + section.transformation, section.width * sizeof(Precision));
+            std::memcpy(offset.data(), file->data() + section.transformation + section.width * sizeof(Precision), section.width * sizeof(Precision));
+            sets[s].setTransformation(scale, offset);
+        }
+    }
+    return true;
+}
+
+Dataset DatasetCache::loadIdx(const std::string &trainingData, const std::string &trainingLabels, const std::string &testData, const std::string &testLabels, const double validationSplit, const bool normalize, const std::string &name) const
+{
+    // the key is built from the metadata of the inputs, a hit neither maps nor reads them
+    std::uint64_t key = msVersion;
+    for (const std::string &input : {trainingData, trainingLabels, testData, testLabels})
+    {
+        const std::string path = std::filesystem::absolute(input).lexically_normal().string();
+        const std::array<std::int64_t, 2> stamp = {static_cast<std::int64_t>(std::filesystem::file_size(path)),
+                                                   static_cast<std::int64_t>(std::filesystem::last_write_time(path).time_since_epoch().count())};
+        key = mHash(reinterpret_cast<const std::byte *>(path.data()), path.size(), key);
+        key = mHash(reinterpret_cast<const std::byte *>(stamp.data()), sizeof(stamp), key);
+    }
+    const std::array<double, 2> parameters = {validationSplit, normalize ? 1.0 : 0.0};
+    key = mHash(reinterpret_cast<const std::byte *>(parameters.data()), sizeof(parameters), key);
+
+    // one generator of the split stream is taken on a hit as well, so the random streams stay in the same state. Without a
+    // seed every run draws another split, the stored one is reused. With a seed the split is part of the key.
+    std::mt19937 generator = Random::generator(Random::Stream::SPLIT);
+    if (Random::isDeterministic())
+    {
+        std::mt19937 probe = generator;
+        const std::array<std::uint32_t, 2> draws = {static_cast<std::uint32_t>(probe()), static_cast<std::uint32_t>(probe())};
+        key = mHash(reinterpret_cast<const std::byte *>(draws.data()), sizeof(draws), key);
+    }
+
+    std::ostringstream fileName;
+    fileName << std::hex << std::setw(16) << std::setfill('0') << key << ".dataset";
+    const std::filesystem::path path = mDirectory / fileName.str();
+
+    std::array<SampleStorage, 6> sets;
+    if (!mRead(path, key, sets))
+    {
+        const std::array<SampleStorage, 4> inputs = {Reader::read_idx_samples(trainingData), Reader::read_idx_samples(trainingLabels),
+                                                     Reader::read_idx_samples(testData), Reader::read_idx_samples(testLabels)};
+        if (inputs[0].size() != inputs[1].size() || inputs[2].size() != inputs[3].size())
+        {
+            throw std::runtime_error("data and labels have different sizes");
+        }
+        std::vector<std::uint32_t> trainingIndices;
+        std::vector<std::uint32_t> validationIndices;
+        Preprocessing::splitIndices(inputs[0].size(), validationSplit, trainingIndices, validationIndices, generator); // the same split as the constructor of Dataset
+        sets = {SampleStorage(inputs[0], trainingIndices), SampleStorage(inputs[1], trainingIndices),
+                SampleStorage(inputs[0], validationIndices), SampleStorage(inputs[1], validationIndices),
+                inputs[2], inputs[3]};
+        if (normalize) // like Dataset::normalize
+        {
+            Preprocessing::Statistics statistics = Preprocessing::statistics(sets[0]);
+            statistics.merge(Preprocessing::statistics(sets[2]));
+            const Precision maximum = static_cast<Precision>(statistics.largest());
+            if (!(maximum > 0))
+            {
+                throw std::invalid_argument("DatasetCache::loadIdx: The largest value of the training set must be positive.");
+            }
+            for (const size_t s : {0, 2, 4})
+            {
+                sets[s].setTransformation({1 / maximum}, {0});
+            }
+        }
+        try
+        {
+            mWrite(path, key, {&sets[0], &sets[1], &sets[2], &sets[3], &sets[4], &sets[5]});
+        }
+        catch (const std::exception &exception) // the dataset is usable without the cache
+        {
+            std::cerr << exception.what() << std::endl;
+        }
+    }
+    return {std::move(sets[0]), std::move(sets[1]), std::move(sets[2]), std::move(sets[3]), std::move(sets[4]), std::move(sets[5]), name};
+}
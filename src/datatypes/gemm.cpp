@@ -0,0 +1,227 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "datatypes/gemm.hpp"
+#include "datatypes/gemm_tuner.hpp"
+#include "datatypes/transpose.hpp"
+#include "parallel.hpp"
+
+template <typename T>
+void Gemm::kernel(const Precision *a, const std::uint64_t lda, const T *b, const std::uint64_t ldb, Precision *c, const std::uint64_t ldc, const std::uint64_t m, const std::uint64_t n, const std::uint64_t k, const std::uint64_t depthBlock, const bool accumulate)
+{
+    if (!accumulate)
+    {
+        for (std::uint64_t i = 0; i < m; i++)
+        {
+            std::fill(c + i * ldc, c + i * ldc + n, static_cast<Precision>(0));
+        }
+    }
+
+    for (std::uint64_t depth = 0; depth < k; depth += depthBlock) // panels of B that stay in cache while all rows use them
+    {
+        const std::uint64_t depthEnd = std::min(k, depth + depthBlock);
+        std::uint64_t i = 0;
+        for (; i + 4 <= m; i += 4) // four rows of C share every loaded row of B
+        {
+            Precision *c0 = c + i * ldc;
+            Precision *c1 = c0 + ldc;
+            Precision *c2 = c1 + ldc;
+            Precision *c3 = c2 + ldc;
+            for (std::uint64_t p = depth; p < depthEnd; p++)
+            {
+                const Precision a0 = a[i * lda + p];
+                const Precision a1 = a[(i + 1) * lda + p];
+                const Precision a2 = a[(i + 2) * lda + p];
+                const Precision a3 = a[(i + 3) * lda + p];
+                const T *pRow = b + p * ldb;
+                for (std::uint64_t j = 0; j < n; j++)
+                {
+                    const Precision value = static_cast<Precision>(pRow[j]);
+                    c0[j] += a0 * value;
+                    c1[j] += a1 * value;
+                    c2[j] += a2 * value;
+                    c3[j] += a3 * value;
+                }
+            }
+        }
+        for (; i < m; i++)
+        {
+            Precision *pResult = c + i * ldc;
+            for (std::uint64_t p = depth; p < depthEnd; p++)
+            {
+                const Precision value = a[i * lda + p];
+                const T *pRow = b + p * ldb;
+                for (std::uint64_t j = 0; j < n; j++)
+                {
+                    pResult[j] += value * static_cast<Precision>(pRow[j]);
+                }
+            }
+        }
+    }
+}
+
+void Gemm::tile(const Problem &problem, const Config &config, const std::uint64_t rowBegin, const std::uint64_t rowEnd, const std::uint64_t columnBegin, const std::uint64_t columnEnd)
+{
+    thread_local std::vector<Precision> packedA;
+    thread_local std::vector<Precision> packedB;
+    const std::uint64_t rows = rowEnd - rowBegin;
+    const std::uint64_t columns = columnEnd - columnBegin;
+
+    // transposed operands are packed into row-major panels, so the kernel only reads rows
+    const Precision *pA = problem.a + rowBegin * problem.k;
+    if (problem.transposeA)
+    {
+        packedA.resize(rows * problem.k);
+        Transpose::strided(problem.a + rowBegin, problem.m, packedA.data(), problem.k, problem.k, rows);
+        pA = packedA.data();
+    }
+    Precision *pC = problem.c + rowBegin * problem.n;
+
+    if (problem.packedB != nullptr) // walk through the panels the columns of the tile lie in
+    {
+        const PackedMatrix &packed = *problem.packedB;
+        for (std::uint64_t column = columnBegin; column < columnEnd;)
+        {
+            const std::uint64_t panel = column / packed.panelWidth();
+            const std::uint64_t offset = column - panel * packed.panelWidth();
+            const std::uint64_t width = packed.width(panel);
+            const std::uint64_t end = std::min(columnEnd, panel * packed.panelWidth() + width);
+            if (packed.reduced())
+            {
+                kernel(pA, problem.k, packed.panel<BFloat16>(panel) + offset, width, pC + column, problem.n, rows, end - column, problem.k, config.depthBlock, problem.accumulate);
+            }
+            else
+            {
+                kernel(pA, problem.k, packed.panel<Precision>(panel) + offset, width, pC + column, problem.n, rows, end - column, problem.k, config.depthBlock, problem.accumulate);
+            }
+            column = end;
+        }
+        return;
+    }
+
+    const Precision *pB = problem.b + columnBegin;
+    std::uint64_t ldb = problem.n;
+    if (problem.transposeB)
+    {
+        packedB.resize(problem.k * columns);
+        Transpose::strided(problem.b + columnBegin * problem.k, problem.k, packedB.data(), columns, columns, problem.k);
+        pB = packedB.data();
+        ldb = columns;
+    }
+
+    kernel(pA, problem.k, pB, ldb, pC + columnBegin, problem.n, rows, columns, problem.k, config.depthBlock, problem.accumulate);
+}
+
+void Gemm::schedule(const std::vector<Problem> &problems, const Config &config)
+{
+    const std::uint32_t threads = config.threads == 0 ? Parallel::threadCount() : std::min(config.threads, Parallel::threadCount());
+    std::vector<WorkItem> items;
+    std::uint64_t totalWork = 0;
+    std::uint64_t groupBegin = 0;
+    std::uint64_t groupWork = 0;
+    auto closeGroup = [&](const std::uint64_t end) {
+        if (groupBegin < end)
+        {
+            items.push_back({groupBegin, end, 0, 0, 0, 0});
+        }
+        groupBegin = end;
+        groupWork = 0;
+    };
+
+    for (std::uint64_t index = 0; index < problems.size(); index++)
+    {
+        const Problem &problem = problems[index];
+        if (problem.packedB != nullptr && (problem.packedB->rows() != problem.k || problem.packedB->columns() != problem.n))
+        {
+            throw std::invalid_argument("Gemm::schedule: The packed matrix does not match the size of the product.");
+        }
+        const std::uint64_t work = problem.m * problem.n * std::max<std::uint64_t>(problem.k, 1);
+        totalWork += work;
+        if (work < Parallel::msMinimumWork) // small products are packed together until the item is worth a thread
+        {
+            groupWork += work;
+            if (groupWork >= Parallel::msMinimumWork)
+            {
+                closeGroup(index + 1);
+            }
+            continue;
+        }
+        closeGroup(index);
+
+        // shrink the tiles of large products until every thread can get one
+        std::uint64_t rowBlock = config.rowBlock;
+        std::uint64_t columnBlock = config.columnBlock;
+        auto tiles = [&]() { return ((problem.m + rowBlock - 1) / rowBlock) * ((problem.n + columnBlock - 1) / columnBlock); };
+        while (tiles() < threads && work / tiles() > 2 * Parallel::msMinimumWork && (rowBlock > 8 || columnBlock > 64))
+        {
+            if (rowBlock > 8 && (rowBlock >= problem.m / 2 || columnBlock <= 64))
+            {
+                rowBlock /= 2;
+            }
+            else
+            {
+                columnBlock /= 2;
+            }
+        }
+        for (std::uint64_t row = 0; row < problem.m; row += rowBlock)
+        {
+            for (std::uint64_t column = 0; column < problem.n; column += columnBlock)
+            {
+                items.push_back({index, index + 1, row, std::min(problem.m, row + rowBlock), column, std::min(problem.n, column + columnBlock)});
+            }
+        }
+        groupBegin = index + 1;
+    }
+    closeGroup(problems.size());
+
+    Parallel::forEach(items.size(), totalWork, [&](const std::uint64_t i) {
+        const WorkItem &item = items[i];
+        if (item.rowEnd == 0) // a group of whole small products
+        {
+            for (std::uint64_t index = item.firstProblem; index < item.lastProblem; index++)
+            {
+                tile(problems[index], config, 0, problems[index].m, 0, problems[index].n);
+            }
+            return;
+        }
+        tile(problems[item.firstProblem], config, item.rowBegin, item.rowEnd, item.columnBegin, item.columnEnd);
+    }, threads);
+}
+
+void Gemm::multiply(const Problem &problem)
+{
+    schedule({problem}, GemmTuner::config(problem, 1));
+}
+
+void Gemm::multiply(const Problem &problem, const Config &config)
+{
+    schedule({problem}, config);
+}
+
+void Gemm::stridedBatched(const Problem &problem, const std::uint64_t batch, const std::uint64_t strideA, const std::uint64_t strideB, const std::uint64_t strideC)
+{
+    if (batch > 1 && strideC < problem.m * problem.n)
+    {
+        throw std::invalid_argument("Gemm::stridedBatched: The result matrices must not overlap.");
+    }
+    std::vector<Problem> problems(batch, problem);
+    for (std::uint64_t i = 0; i < batch; i++)
+    {
+        problems[i].a = problem.a + i * strideA;
+        problems[i].b = problem.b + i * strideB;
+        problems[i].c = problem.c + i * strideC;
+    }
+    schedule(problems, GemmTuner::config(problem, batch));
+}
+
+void Gemm::batched(const std::vector<Problem> &problems)
+{
+    if (problems.empty())
+    {
+        return;
+    }
+    // the shapes differ, so the configuration of the largest product is used for all of them
+    const Problem &largest = *std::ranges::max_element(problems, {}, [](const Problem &problem) { return problem.m * problem.n * problem.k; });
+    schedule(problems, GemmTuner::config(largest, problems.size()));
+}
@@ -0,0 +1,207 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "datatypes/gemm_tuner.hpp"
+#include "parallel.hpp"
+
+std::map<std::string, Gemm::Config> GemmTuner::msConfigs;
+std::set<std::string> GemmTuner::msTuning;
+std::mutex GemmTuner::msMutex;
+std::atomic<bool> GemmTuner::msEnabled = false;
+bool GemmTuner::msLoaded = false;
+std::filesystem::path GemmTuner::msCacheDirectory = "data/cache";
+
+std::string GemmTuner::cpuModel()
+{
+    std::ifstream file("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.starts_with("model name"))
+        {
+            std::string model = line.substr(line.find(':') + 1);
+            model.erase(0, model.find_first_not_of(' '));
+            std::ranges::replace(model, '|', ' '); // '|' separates the fields of the cache file
+            return model;
+        }
+    }
+    return "unknown";
+}
+
+std::string GemmTuner::key(const Gemm::Problem &problem, const std::uint64_t batch)
+{
+    // similar shapes share a configuration
+    return "m" + std::to_string(std::bit_ceil(problem.m)) +
+           " n" + std::to_string(std::bit_ceil(problem.n)) +
+           " k" + std::to_string(std::bit_ceil(problem.k)) +
+           " batch" + std::to_string(std::bit_ceil(batch)) +
+           (problem.transposeA ? " tA" : "") + (problem.transposeB ? " tB" : "") +
+           (sizeof(Precision) == sizeof(float) ? " float" : " double") +
+           " threads" + std::to_string(Parallel::threadCount());
+}
+
+void GemmTuner::load()
+{
+    msLoaded = true;
+    std::ifstream file(msCacheDirectory / msCacheFile);
+    const std::string model = cpuModel();
+    std::string line;
+    while (std::getline(file, line)) // every line: cpu model|key|rowBlock columnBlock depthBlock threads
+    {
+        std::istringstream stream(line);
+        std::string lineModel, lineKey;
+        Gemm::Config config;
+        if (std::getline(stream, lineModel, '|') && std::getline(stream, lineKey, '|') &&
+            stream >> config.rowBlock >> config.columnBlock >> config.depthBlock >> config.threads && lineModel == model)
+        {
+            msConfigs[lineKey] = config;
+        }
+    }
+}
+
+void GemmTuner::store(const std::string &key, const Gemm::Config &config)
+{
+    std::error_code error;
+    std::filesystem::create_directories(msCacheDirectory, error);
+    std::ofstream file(msCacheDirectory / msCacheFile, std::ios::app);
+    if (!file) // the cache only saves time, without it the next run tunes again
+    {
+        return;
+    }
+    file << cpuModel() << '|' << key << '|' << config.rowBlock << ' ' << config.columnBlock << ' ' << config.depthBlock << ' ' << config.threads << '\n';
+}
+
+Gemm::Config GemmTuner::tune(const Gemm::Problem &problem, const std::uint64_t batch)
+{
+    // scratch matrices of the same shape, the real operands must not be touched
+    std::vector<Precision> a(batch * problem.m * problem.k, static_cast<Precision>(0.5));
+    std::vector<Precision> b(batch * problem.k * problem.n, static_cast<Precision>(0.5));
+    std::vector<Precision> c(batch * problem.m * problem.n);
+    std::vector<Gemm::Problem> problems(batch, problem);
+    for (std::uint64_t i = 0; i < batch; i++)
+    {
+        problems[i].a = a.data() + i * problem.m * problem.k;
+        problems[i].b = b.data() + i * problem.k * problem.n;
+        problems[i].c = c.data() + i * problem.m * problem.n;
+        problems[i].packedB = nullptr;
+    }
+
+    auto measure = [&](const Gemm::Config &config) {
+        double fastest = std::numeric_limits<double>::max();
+        for (std::uint32_t i = 0; i < msRepetitions; i++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            Gemm::schedule(problems, config);
+            fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+        return fastest;
+    };
+
+    // search one parameter at a time, starting from the default configuration
+    Gemm::Config best;
+    double bestTime = measure(best);
+    auto tryCandidates = [&](std::uint64_t Gemm::Config::*parameter, const std::vector<std::uint64_t> &values) {
+        const Gemm::Config current = best;
+        for (const std::uint64_t value : values)
+        {
+            Gemm::Config candidate = current;
+            candidate.*parameter = value;
+            if (value == current.*parameter)
+            {
+                continue;
+            }
+            const double time = measure(candidate);
+            if (time < bestTime)
+            {
+                bestTime = time;
+                best = candidate;
+            }
+        }
+    };
+
+    for (std::uint32_t threads = Parallel::threadCount() / 2; threads >= 1; threads /= 2) // fewer threads can win for memory bound shapes
+    {
+        Gemm::Config candidate = best;
+        candidate.threads = threads;
+        const double time = measure(candidate);
+        if (time < bestTime)
+        {
+            bestTime = time;
+            best = candidate;
+        }
+    }
+    tryCandidates(&Gemm::Config::rowBlock, {16, 32, 64, 128});
+    tryCandidates(&Gemm::Config::columnBlock, {64, 128, 256, 512});
+    tryCandidates(&Gemm::Config::depthBlock, {64, 128, 256, 512});
+    return best;
+}
+
+Gemm::Config GemmTuner::config(const Gemm::Problem &problem, const std::uint64_t batch)
+{
+    const std::uint64_t work = batch * problem.m * problem.n * problem.k;
+    const std::uint64_t scratch = batch * (problem.m * problem.k + problem.k * problem.n + problem.m * problem.n);
+    if (!msEnabled || work < msMinimumWork || scratch > msMaximumScratch)
+    {
+        return {};
+    }
+
+    const std::string problemKey = key(problem, batch);
+    {
+        std::lock_guard<std::mutex> lock(msMutex);
+        if (!msLoaded)
+        {
+            load();
+        }
+        if (const auto iterator = msConfigs.find(problemKey); iterator != msConfigs.end())
+        {
+            return iterator->second;
+        }
+        if (!msTuning.insert(problemKey).second) // another thread is tuning this shape, do not wait for it
+        {
+            return {};
+        }
+    }
+
+    // the benchmark runs without the lock, so threads that need other shapes are not stalled
+    Gemm::Config config;
+    try
+    {
+        config = tune(problem, batch);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(msMutex);
+        msTuning.erase(problemKey);
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(msMutex);
+    msTuning.erase(problemKey);
+    const auto [iterator, inserted] = msConfigs.emplace(problemKey, config); // the cache may have been reloaded meanwhile
+    if (inserted)
+    {
+        store(problemKey, config);
+    }
+    return iterator->second;
+}
+
+void GemmTuner::setEnabled(const bool enabled)
+{
+    msEnabled = enabled;
+}
+
+void GemmTuner::setCacheDirectory(const std::filesystem::path &directory)
+{
+    std::lock_guard<std::mutex> lock(msMutex);
+    msCacheDirectory = directory;
+    msConfigs.clear();
+    msLoaded = false;
+}
+
+void GemmTuner::clear()
+{
+    std::lock_guard<std::mutex> lock(msMutex);
+    msConfigs.clear();
+    msLoaded = false;
+}
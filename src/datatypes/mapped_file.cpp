@@ -0,0 +1,77 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "datatypes/mapped_file.hpp"
+
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string &path)
+{
+#if defined(__unix__)
+    const int descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0)
+    {
+        throw std::invalid_argument("MappedFile::MappedFile: Could not open " + path);
+    }
+    struct stat status{};
+    if (fstat(descriptor, &status) != 0)
+    {
+        close(descriptor);
+        throw std::runtime_error("MappedFile::MappedFile: Could not get the size of " + path);
+    }
+    mSize = static_cast<std::uint64_t>(status.st_size);
+    if (mSize > 0) // an empty file can not be mapped
+    {
+        void *pMapping = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (pMapping == MAP_FAILED)
+        {
+            close(descriptor);
+            throw std::runtime_error("MappedFile::MappedFile: Could not map " + path);
+        }
+        madvise(pMapping, mSize, MADV_WILLNEED); // start reading ahead, the batches touch the samples in random order
+        mpData = static_cast<const std::byte *>(pMapping);
+    }
+    close(descriptor); // the mapping stays valid
+#else
+    std::ifstream file(std::filesystem::path(path), std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        throw std::invalid_argument("MappedFile::MappedFile: Could not open " + path);
+    }
+    mBuffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(mBuffer.data()), static_cast<std::streamsize>(mBuffer.size()));
+    if (!file)
+    {
+        throw std::runtime_error("MappedFile::MappedFile: Could not read " + path);
+    }
+    mpData = mBuffer.data();
+    mSize = mBuffer.size();
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(__unix__)
+    if (mpData != nullptr)
+    {
+        munmap(const_cast<std::byte *>(mpData), mSize);
+    }
+#endif
+}
+
+const std::byte *MappedFile::data() const
+{
+    return mpData;
+}
+
+std::uint64_t MappedFile::size() const
+{
+    return mSize;
+}
@@ -0,0 +1,38 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "datatypes/packed_matrix.hpp"
+#include "datatypes/transpose.hpp"
+#include "parallel.hpp"
+
+PackedMatrix::PackedMatrix(const Precision *source, const std::uint64_t rows, const std::uint64_t columns, const bool transpose, const bool reduced, const std::uint64_t panelWidth) :
+mRows(rows), mColumns(columns), mPanelWidth(panelWidth), mReduced(reduced)
+{
+    if (panelWidth == 0)
+    {
+        throw std::invalid_argument("PackedMatrix::PackedMatrix: The panel width must be positive.");
+    }
+    mPanels.resize(rows * columns);
+    const std::uint64_t panels = (columns + panelWidth - 1) / panelWidth;
+    Parallel::forEach(panels, rows * columns, [&](const std::uint64_t panel) {
+        const std::uint64_t begin = panel * panelWidth;
+        const std::uint64_t panelColumns = width(panel);
+        Precision *pPanel = mPanels.data() + begin * rows;
+        if (transpose) // the columns of B are the rows of the source
+        {
+            Transpose::strided(source + begin * rows, rows, pPanel, panelColumns, panelColumns, rows);
+            return;
+        }
+        for (std::uint64_t row = 0; row < rows; row++)
+        {
+            std::copy_n(source + row * columns + begin, panelColumns, pPanel + row * panelColumns);
+        }
+    });
+
+    if (reduced)
+    {
+        mReducedPanels.assign(mPanels.begin(), mPanels.end());
+        mPanels = std::vector<Precision>();
+    }
+}
@@ -0,0 +1,104 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "datatypes/reduced_precision.hpp"
+
+#if defined(__F16C__) && defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+Float16::Float16(const float value)
+{
+    const auto bits = std::bit_cast<std::uint32_t>(value);
+    const auto sign = static_cast<std::uint16_t>(bits >> 16 & 0x8000);
+    std::uint32_t absolute = bits & 0x7FFFFFFF;
+
+    if (absolute >= 0x7F800000) // infinity or NaN
+    {
+        mBits = sign | 0x7C00 | (absolute > 0x7F800000 ? 0x0200 | (absolute >> 13 & 0x3FF) : 0);
+    }
+    else if (absolute >= 0x477FF000) // too large for half precision, rounds to infinity
+    {
+        mBits = sign | 0x7C00;
+    }
+    else if (absolute < 0x38800000) // subnormal or zero, let the float unit do the rounding
+    {
+        const float shifted = std::bit_cast<float>(absolute) + 0.5f;
+        mBits = sign | static_cast<std::uint16_t>(std::bit_cast<std::uint32_t>(shifted) - 0x3F000000);
+    }
+    else // normal number, rebias the exponent and round to nearest even
+    {
+        absolute += 0xC8000FFF + (absolute >> 13 & 1);
+        mBits = sign | static_cast<std::uint16_t>(absolute >> 13);
+    }
+}
+
+Float16::operator float() const
+{
+    const std::uint32_t sign = static_cast<std::uint32_t>(mBits & 0x8000) << 16;
+    const std::uint32_t exponent = mBits >> 10 & 0x1F;
+    const std::uint32_t mantissa = mBits & 0x3FF;
+
+    if (exponent == 0) // zero or subnormal
+    {
+        return std::bit_cast<float>(sign | std::bit_cast<std::uint32_t>(static_cast<float>(mantissa) * 5.9604645e-8f)); // mantissa * 2^-24
+    }
+    if (exponent == 31) // infinity or NaN
+    {
+        return std::bit_cast<float>(sign | 0x7F800000 | mantissa << 13);
+    }
+    return std::bit_cast<float>(sign | (exponent + 112) << 23 | mantissa << 13);
+}
+
+void convertElements(const float *pSource, BFloat16 *pDestination, const std::size_t n)
+{
+    // branch free version of BFloat16(float) so the compiler can vectorize the loop
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const auto bits = std::bit_cast<std::uint32_t>(pSource[i]);
+        const std::uint32_t rounded = (bits + 0x7FFF + (bits >> 16 & 1)) >> 16;
+        const std::uint32_t quietNaN = bits >> 16 | 0x0040;
+        pDestination[i].mBits = static_cast<std::uint16_t>((bits & 0x7FFFFFFF) > 0x7F800000 ? quietNaN : rounded);
+    }
+}
+
+void convertElements(const BFloat16 *pSource, float *pDestination, const std::size_t n)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        pDestination[i] = std::bit_cast<float>(static_cast<std::uint32_t>(pSource[i].mBits) << 16);
+    }
+}
+
+void convertElements(const float *pSource, Float16 *pDestination, const std::size_t n)
+{
+    std::size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+    for (; i + 8 <= n; i += 8) // hardware conversion of 8 elements at once
+    {
+        const __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(pSource + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pDestination + i), half);
+    }
+#endif
+    for (; i < n; i++)
+    {
+        pDestination[i] = Float16(pSource[i]);
+    }
+}
+
+void convertElements(const Float16 *pSource, float *pDestination, const std::size_t n)
+{
+    std::size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+    for (; i + 8 <= n; i += 8) // hardware conversion of 8 elements at once
+    {
+        const __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSource + i));
+        _mm256_storeu_ps(pDestination + i, _mm256_cvtph_ps(half));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        pDestination[i] = static_cast<float>(pSource[i]);
+    }
+}
@@ -0,0 +1,260 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "datatypes/reduction.hpp"
+
+namespace
+{
+    /**
+     * @brief pairwise summation of the rows value(a, 0..inner) for a in [begin, end) into out
+     * Summing whole rows keeps the memory access contiguous when the reduced axis is not the last one.
+     */
+    template <typename F>
+    void pairwiseRows(F &value, const std::uint64_t begin, const std::uint64_t end, const std::uint64_t inner, Precision *out)
+    {
+        if (end - begin <= 8)
+        {
+            for (std::uint64_t j = 0; j < inner; j++)
+            {
+                out[j] = value(begin, j);
+            }
+            for (std::uint64_t a = begin + 1; a < end; a++)
+            {
+                for (std::uint64_t j = 0; j < inner; j++)
+                {
+                    out[j] += value(a, j);
+                }
+            }
+            return;
+        }
+        const std::uint64_t middle = begin + (end - begin) / 2;
+        std::vector<Precision> right(inner);
+        pairwiseRows(value, begin, middle, inner, out);
+        pairwiseRows(value, middle, end, inner, right.data());
+        for (std::uint64_t j = 0; j < inner; j++)
+        {
+            out[j] += right[j];
+        }
+    }
+}
+
+Tensor Reduction::reduceAxis(Tensor &input, const size_t axis, const Kind kind)
+{
+    ShapeVector shape = input.shape();
+    if (axis >= shape.size())
+    {
+        throw std::invalid_argument("Reduction::reduceAxis: The axis is out of range.");
+    }
+    if (shape[axis] == 0)
+    {
+        throw std::invalid_argument("Reduction::reduceAxis: Cannot reduce an empty axis.");
+    }
+
+    const std::uint64_t outer = std::accumulate(shape.begin(), shape.begin() + axis, size_t{1}, std::multiplies<>());
+    const std::uint64_t length = shape[axis];
+    const std::uint64_t inner = std::accumulate(shape.begin() + axis + 1, shape.end(), size_t{1}, std::multiplies<>());
+
+    shape[axis] = 1;
+    Tensor result(shape);
+    const Precision *pInput = input.data();
+    Precision *pResult = result.data();
+
+    Parallel::forRange(outer, outer * length * inner, [&](const std::uint64_t first, const std::uint64_t last) {
+        for (std::uint64_t o = first; o < last; o++)
+        {
+            const Precision *pSlice = pInput + o * length * inner; // the (length, inner) slice that is reduced
+            Precision *pOut = pResult + o * inner;
+
+            if (kind == Kind::SUM)
+            {
+                auto value = [&](const std::uint64_t a, const std::uint64_t j) { return pSlice[a * inner + j]; };
+                pairwiseRows(value, 0, length, inner, pOut);
+                continue;
+            }
+
+            // maximum, also needed to shift the exponentials of log-sum-exp
+            std::copy(pSlice, pSlice + inner, pOut);
+            for (std::uint64_t a = 1; a < length; a++)
+            {
+                for (std::uint64_t j = 0; j < inner; j++)
+                {
+                    pOut[j] = std::max(pOut[j], pSlice[a * inner + j]);
+                }
+            }
+
+            if (kind == Kind::LOG_SUM_EXP)
+            {
+                std::vector<Precision> maximum(pOut, pOut + inner);
+                for (Precision &m : maximum)
+                {
+                    m = std::isfinite(m) ? m : 0; // all -inf (or inf) columns keep their value through log(sum)
+                }
+                auto value = [&](const std::uint64_t a, const std::uint64_t j) { return std::exp(pSlice[a * inner + j] - maximum[j]); };
+                pairwiseRows(value, 0, length, inner, pOut);
+                for (std::uint64_t j = 0; j < inner; j++)
+                {
+                    pOut[j] = maximum[j] + std::log(pOut[j]);
+                }
+            }
+        }
+    });
+
+    return result;
+}
+
+Tensor Reduction::reduce(Tensor &input, const ShapeVector &axes, const Kind kind)
+{
+    ShapeVector sorted = axes;
+    std::ranges::sort(sorted, std::greater<>());
+    if (std::ranges::adjacent_find(sorted) != sorted.end())
+    {
+        throw std::invalid_argument("Reduction::reduce: Every axis can only be reduced once.");
+    }
+    if (sorted.empty())
+    {
+        return input;
+    }
+
+    // reducing the axes one after another is exact for sum and max and also for log-sum-exp
+    Tensor result = reduceAxis(input, sorted[0], kind);
+    for (std::uint32_t i = 1; i < sorted.size(); i++)
+    {
+        result = reduceAxis(result, sorted[i], kind);
+    }
+    return result;
+}
+
+void Reduction::squeeze(Tensor &tensor, const ShapeVector &axes)
+{
+    const ShapeVector shape = tensor.shape();
+    ShapeVector squeezed;
+    for (size_t i = 0; i < shape.size(); i++)
+    {
+        if (std::ranges::find(axes, i) == axes.end())
+        {
+            squeezed.push_back(shape[i]);
+        }
+    }
+    if (squeezed.empty()) // scalars are stored as tensors of shape {1}
+    {
+        squeezed.push_back(1);
+    }
+    tensor.reshape(squeezed);
+}
+
+Precision Reduction::sum(Tensor &input)
+{
+    const Precision *pData = input.data();
+    return sumOf(input.capacity(), [pData](const std::uint64_t i) { return pData[i]; });
+}
+
+Precision Reduction::mean(Tensor &input)
+{
+    if (input.capacity() == 0)
+    {
+        throw std::invalid_argument("Reduction::mean: The tensor is empty.");
+    }
+    return sum(input) / static_cast<Precision>(input.capacity());
+}
+
+Precision Reduction::max(Tensor &input)
+{
+    if (input.capacity() == 0)
+    {
+        throw std::invalid_argument("Reduction::max: The tensor is empty.");
+    }
+    return *std::max_element(input.data(), input.data() + input.capacity());
+}
+
+Tensor Reduction::sum(Tensor &input, const ShapeVector &axes, const bool keepDims)
+{
+    Tensor result = reduce(input, axes, Kind::SUM);
+    if (!keepDims)
+    {
+        squeeze(result, axes);
+    }
+    return result;
+}
+
+Tensor Reduction::mean(Tensor &input, const ShapeVector &axes, const bool keepDims)
+{
+    Tensor result = sum(input, axes, keepDims);
+    size_t count = 1;
+    for (const size_t axis : axes)
+    {
+        count *= input.shape(axis);
+    }
+    Precision *pData = result.data();
+    for (size_t i = 0; i < result.capacity(); i++)
+    {
+        pData[i] /= static_cast<Precision>(count);
+    }
+    return result;
+}
+
+Tensor Reduction::max(Tensor &input, const ShapeVector &axes, const bool keepDims)
+{
+    Tensor result = reduce(input, axes, Kind::MAX);
+    if (!keepDims)
+    {
+        squeeze(result, axes);
+    }
+    return result;
+}
+
+Tensor Reduction::logSumExp(Tensor &input, const ShapeVector &axes, const bool keepDims)
+{
+    Tensor result = reduce(input, axes, Kind::LOG_SUM_EXP);
+    if (!keepDims)
+    {
+        squeeze(result, axes);
+    }
+    return result;
+}
+
+Tensor Reduction::argmax(Tensor &input, const size_t axis, const bool keepDims)
+{
+    ShapeVector shape = input.shape();
+    if (axis >= shape.size())
+    {
+        throw std::invalid_argument("Reduction::argmax: The axis is out of range.");
+    }
+
+    const std::uint64_t outer = std::accumulate(shape.begin(), shape.begin() + axis, size_t{1}, std::multiplies<>());
+    const std::uint64_t length = shape[axis];
+    const std::uint64_t inner = std::accumulate(shape.begin() + axis + 1, shape.end(), size_t{1}, std::multiplies<>());
+
+    shape[axis] = 1;
+    Tensor result(shape);
+    const Precision *pInput = input.data();
+    Precision *pResult = result.data();
+
+    Parallel::forRange(outer, outer * length * inner, [&](const std::uint64_t first, const std::uint64_t last) {
+        std::vector<Precision> maximum(inner);
+        for (std::uint64_t o = first; o < last; o++)
+        {
+            const Precision *pSlice = pInput + o * length * inner;
+            Precision *pOut = pResult + o * inner;
+            std::copy(pSlice, pSlice + inner, maximum.begin());
+            std::fill(pOut, pOut + inner, static_cast<Precision>(0));
+            for (std::uint64_t a = 1; a < length; a++)
+            {
+                for (std::uint64_t j = 0; j < inner; j++)
+                {
+                    if (pSlice[a * inner + j] > maximum[j])
+                    {
+                        maximum[j] = pSlice[a * inner + j];
+                        pOut[j] = static_cast<Precision>(a);
+                    }
+                }
+            }
+        }
+    });
+
+    if (!keepDims)
+    {
+        squeeze(result, {axis});
+    }
+    return result;
+}
@@ -0,0 +1,239 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "datatypes/sample_storage.hpp"
+
+#include <cstring>
+
+SampleStorage::SampleStorage(std::vector<Precision> values, const std::uint64_t width) : mCount(values.size()), mWidth(width)
+{
+    std::shared_ptr<std::vector<Precision>> pValues = std::make_shared<std::vector<Precision>>(std::move(values));
+    mpValues = reinterpret_cast<const std::byte *>(pValues->data());
+    mpOwner = std::move(pValues);
+    mCheckWidth();
+}
+
+SampleStorage::SampleStorage(std::vector<std::uint8_t> values, const std::uint64_t width) : mCount(values.size()), mType(Type::UINT8), mWidth(width)
+{
+    std::shared_ptr<std::vector<std::uint8_t>> pValues = std::make_shared<std::vector<std::uint8_t>>(std::move(values));
+    mpValues = reinterpret_cast<const std::byte *>(pValues->data());
+    mpOwner = std::move(pValues);
+    mCheckWidth();
+}
+
+SampleStorage::SampleStorage(std::shared_ptr<const void> pOwner, const std::byte *pValues, const Type type, const bool bigEndian, const std::uint64_t count, const std::uint64_t width) :
+mpOwner(std::move(pOwner)),
+mpValues(pValues),
+mCount(count),
+mType(type),
+mSwap(elementSize(type) > 1 && bigEndian != (std::endian::native == std::endian::big)),
+mWidth(width)
+{
+    mCheckWidth();
+}
+
+SampleStorage::SampleStorage(const std::vector<std::vector<Precision>> &rows) : mWidth(rows.empty() ? 0 : rows[0].size())
+{
+    std::vector<Precision> values;
+    values.reserve(rows.size() * mWidth);
+    for (const std::vector<Precision> &row : rows)
+    {
+        if (row.size() != mWidth)
+        {
+            throw std::invalid_argument("SampleStorage::SampleStorage: All rows must have the same width.");
+        }
+        values.insert(values.end(), row.begin(), row.end());
+    }
+    *this = SampleStorage(std::move(values), mWidth);
+}
+
+SampleStorage::SampleStorage(const SampleStorage &source, const std::vector<std::uint32_t> &indices) : SampleStorage(source)
+{
+    std::shared_ptr<std::vector<std::uint32_t>> pRows = std::make_shared<std::vector<std::uint32_t>>(indices.size());
+    for (size_t i = 0; i < indices.size(); i++)
+    {
+        if (indices[i] >= source.size())
+        {
+            throw std::out_of_range("SampleStorage::SampleStorage: The row does not exist.");
+        }
+        (*pRows)[i] = source.mpRows != nullptr ? (*source.mpRows)[indices[i]] : indices[i];
+    }
+    mpRows = std::move(pRows);
+}
+
+void SampleStorage::mCheckWidth() const
+{
+    if ((mWidth == 0 && mCount != 0) || (mWidth != 0 && mCount % mWidth != 0))
+    {
+        throw std::invalid_argument("SampleStorage::SampleStorage: The number of values must be a multiple of the width.");
+    }
+}
+
+std::uint64_t SampleStorage::elementSize(const Type type)
+{
+    switch (type)
+    {
+        case Type::UINT8:
+        case Type::INT8:
+            return 1;
+        case Type::INT16:
+            return 2;
+        case Type::INT32:
+        case Type::FLOAT32:
+            return 4;
+        case Type::FLOAT64:
+            return 8;
+    }
+    throw std::invalid_argument("SampleStorage::elementSize: Unknown type.");
+}
+
+std::uint64_t SampleStorage::size() const
+{
+    if (mpRows != nullptr)
+    {
+        return mpRows->size();
+    }
+    return mWidth == 0 ? 0 : mCount / mWidth;
+}
+
+std::uint64_t SampleStorage::width() const
+{
+    return mWidth;
+}
+
+bool SampleStorage::empty() const
+{
+    return size() == 0;
+}
+
+SampleStorage::Type SampleStorage::type() const
+{
+    return mType;
+}
+
+const std::byte *SampleStorage::rawRow(const std::uint64_t index) const
+{
+    return mpValues + (mpRows != nullptr ? (*mpRows)[index] : index) * mWidth * elementSize(mType);
+}
+
+bool SampleStorage::bigEndian() const
+{
+    return mSwap != (std::endian::native == std::endian::big);
+}
+
+const std::vector<Precision> &SampleStorage::scale() const
+{
+    return mScale;
+}
+
+const std::vector<Precision> &SampleStorage::offset() const
+{
+    return mOffset;
+}
+
+std::uint64_t SampleStorage::bytes() const
+{
+    return size() * mWidth * elementSize(mType);
+}
+
+void SampleStorage::setTransformation(const std::vector<Precision> &scale, const std::vector<Precision> &offset)
+{
+    if (scale.empty())
+    {
+        mScale.clear();
+        mOffset.clear();
+        return;
+    }
+    auto expand = [&](const std::vector<Precision> &values, const Precision fill) {
+        if (values.size() > 1 && values.size() != mWidth)
+        {
+            throw std::invalid_argument("SampleStorage::setTransformation: The transformation needs one value or one value per feature.");
+        }
+        return values.size() == mWidth ? values : std::vector<Precision>(mWidth, values.empty() ? fill : values[0]);
+    };
+    mScale = expand(scale, 1);
+    mOffset = expand(offset, 0);
+}
+
+template <typename T>
+T SampleStorage::mSwapBytes(const T value)
+{
+    typedef std::conditional_t<sizeof(T) == 2, std::uint16_t, std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>> Bits;
+    Bits bits = std::bit_cast<Bits>(value);
+    Bits swapped = 0;
+    for (size_t b = 0; b < sizeof(T); b++) // compiled to a single byte swap instruction
+    {
+        swapped = static_cast<Bits>(swapped << 8 | (bits & 0xFF));
+        bits = static_cast<Bits>(bits >> 8);
+    }
+    return std::bit_cast<T>(swapped);
+}
+
+template <typename T, bool Swap>
+void SampleStorage::mConvert(const std::byte *pSource, const Precision *pScale, const Precision *pOffset, Precision *pDestination, const std::uint64_t count)
+{
+    auto load = [pSource](const std::uint64_t j) {
+        T value;
+        std::memcpy(&value, pSource + j * sizeof(T), sizeof(T)); // the values of a mapped file need not be aligned
+        if constexpr (Swap)
+        {
+            value = mSwapBytes(value);
+        }
+        return static_cast<Precision>(value);
+    };
+    if (pScale == nullptr)
+    {
+        for (std::uint64_t j = 0; j < count; j++)
+        {
+            pDestination[j] = load(j);
+        }
+        return;
+    }
+    for (std::uint64_t j = 0; j < count; j++)
+    {
+        pDestination[j] = load(j) * pScale[j] + pOffset[j];
+    }
+}
+
+void SampleStorage::mConvert(const std::uint64_t first, const std::uint64_t count, const Precision *pScale, const Precision *pOffset, Precision *pDestination) const
+{
+    const std::byte *pSource = mpValues + first * elementSize(mType);
+    auto convert = [&]<typename T>() {
+        if constexpr (sizeof(T) > 1)
+        {
+            if (mSwap)
+            {
+                mConvert<T, true>(pSource, pScale, pOffset, pDestination, count);
+                return;
+            }
+        }
+        mConvert<T, false>(pSource, pScale, pOffset, pDestination, count);
+    };
+    switch (mType)
+    {
+        case Type::UINT8: convert.operator()<std::uint8_t>(); break;
+        case Type::INT8: convert.operator()<std::int8_t>(); break;
+        case Type::INT16: convert.operator()<std::int16_t>(); break;
+        case Type::INT32: convert.operator()<std::int32_t>(); break;
+        case Type::FLOAT32: convert.operator()<float>(); break;
+        case Type::FLOAT64: convert.operator()<double>(); break;
+    }
+}
+
+void SampleStorage::copyRow(const std::uint64_t index, Precision *pDestination, const bool transform) const
+{
+    const std::uint64_t row = mpRows != nullptr ? (*mpRows)[index] : index;
+    const bool transformed = transform && !mScale.empty();
+    mConvert(row * mWidth, mWidth, transformed ? mScale.data() : nullptr, transformed ? mOffset.data() : nullptr, pDestination);
+}
+
+std::shared_ptr<Tensor> SampleStorage::tensor() const
+{
+    std::shared_ptr<Tensor> matrix = std::make_shared<Tensor>(Tensor({size(), mWidth}, 0));
+    for (std::uint64_t i = 0; i < size(); i++)
+    {
+        copyRow(i, matrix->data() + i * mWidth);
+    }
+    return matrix;
+}
@@ -0,0 +1,165 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "datatypes/sparse_matrix.hpp"
+#include "parallel.hpp"
+
+SparseMatrix::SparseMatrix(Matrix &dense) : mShape({dense.shape(0), dense.shape(1)})
+{
+    const Precision *pData = dense.data();
+    const size_t rows = mShape[0];
+    const size_t cols = mShape[1];
+
+    mRowOffsets.reserve(rows + 1);
+    mRowOffsets.push_back(0);
+    for (size_t i = 0; i < rows; i++)
+    {
+        for (size_t j = 0; j < cols; j++)
+        {
+            if (pData[i * cols + j] != 0)
+            {
+                mValues.push_back(pData[i * cols + j]);
+                mColumnIndices.push_back(j);
+            }
+        }
+        mRowOffsets.push_back(mValues.size());
+    }
+}
+
+SparseMatrix::SparseMatrix(const std::uint32_t rows, const std::uint32_t cols, const std::vector<std::uint32_t> &rowIndices, const std::vector<std::uint32_t> &colIndices, const std::vector<Precision> &values) : mShape({rows, cols})
+{
+    if (rowIndices.size() != colIndices.size() || rowIndices.size() != values.size())
+    {
+        throw std::invalid_argument("SparseMatrix::SparseMatrix: The coordinate vectors must have the same size.");
+    }
+
+    // sort the coordinates row-major
+    std::vector<std::uint32_t> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [&](const std::uint32_t a, const std::uint32_t b) {
+        return rowIndices[a] != rowIndices[b] ? rowIndices[a] < rowIndices[b] : colIndices[a] < colIndices[b];
+    });
+
+    mRowOffsets.assign(rows + 1, 0);
+    for (std::uint32_t k = 0; k < order.size(); k++)
+    {
+        const std::uint32_t i = order[k];
+        if (rowIndices[i] >= rows || colIndices[i] >= cols)
+        {
+            throw std::out_of_range("SparseMatrix::SparseMatrix: Coordinate out of range.");
+        }
+        if (k > 0 && rowIndices[i] == rowIndices[order[k - 1]] && colIndices[i] == colIndices[order[k - 1]]) // duplicate coordinate
+        {
+            mValues.back() += values[i];
+            continue;
+        }
+        mValues.push_back(values[i]);
+        mColumnIndices.push_back(colIndices[i]);
+        mRowOffsets[rowIndices[i] + 1]++; // count the values per row
+    }
+    for (std::uint32_t i = 1; i <= rows; i++) // turn the counts into offsets
+    {
+        mRowOffsets[i] += mRowOffsets[i - 1];
+    }
+}
+
+Precision SparseMatrix::sparsity(Matrix &dense)
+{
+    if (dense.capacity() == 0)
+    {
+        return 0;
+    }
+    const Precision *pData = dense.data();
+    size_t zeros = 0;
+    for (size_t i = 0; i < dense.capacity(); i++)
+    {
+        zeros += pData[i] == 0;
+    }
+    return static_cast<Precision>(zeros) / static_cast<Precision>(dense.capacity());
+}
+
+Matrix SparseMatrix::toDense() const
+{
+    Matrix dense({mShape[0], mShape[1]}, 0);
+    Precision *pData = dense.data();
+    for (size_t i = 0; i < mShape[0]; i++)
+    {
+        for (std::uint32_t k = mRowOffsets[i]; k < mRowOffsets[i + 1]; k++)
+        {
+            pData[i * mShape[1] + mColumnIndices[k]] = mValues[k];
+        }
+    }
+    return dense;
+}
+
+void SparseMatrix::multiply(Matrix &right, Matrix &result) const
+{
+    if (right.shape(0) != mShape[1] || result.shape(0) != mShape[0] || result.shape(1) != right.shape(1))
+    {
+        throw std::invalid_argument("SparseMatrix::multiply: Invalid shapes of the matrices.");
+    }
+
+    const size_t n = right.shape(1);
+    const Precision *pRight = right.data();
+    Precision *pResult = result.data();
+
+    // every row of the result is a linear combination of the rows of the right matrix selected by the non-zeros
+    Parallel::forRange(mShape[0], mValues.size() * n, [&](const std::uint64_t begin, const std::uint64_t end) {
+        for (std::uint64_t i = begin; i < end; i++)
+        {
+            Precision *pRow = pResult + i * n;
+            std::fill(pRow, pRow + n, static_cast<Precision>(0));
+            for (std::uint32_t k = mRowOffsets[i]; k < mRowOffsets[i + 1]; k++)
+            {
+                const Precision value = mValues[k];
+                const Precision *pRightRow = pRight + mColumnIndices[k] * n;
+                for (size_t j = 0; j < n; j++)
+                {
+                    pRow[j] += value * pRightRow[j];
+                }
+            }
+        }
+    });
+}
+
+void SparseMatrix::transposeMultiply(Matrix &right, Matrix &result) const
+{
+    if (right.shape(0) != mShape[0] || result.shape(0) != mShape[1] || result.shape(1) != right.shape(1))
+    {
+        throw std::invalid_argument("SparseMatrix::transposeMultiply: Invalid shapes of the matrices.");
+    }
+
+    const size_t n = right.shape(1);
+    const Precision *pRight = right.data();
+    Precision *pResult = result.data();
+    std::fill(pResult, pResult + result.capacity(), static_cast<Precision>(0));
+
+    // scatter every row of the right matrix into the result rows selected by the non-zeros,
+    // the threads own disjoint column ranges of the result so no synchronization is needed
+    Parallel::forRange(n, mValues.size() * n, [&](const std::uint64_t begin, const std::uint64_t end) {
+        for (size_t i = 0; i < mShape[0]; i++)
+        {
+            const Precision *pRightRow = pRight + i * n;
+            for (std::uint32_t k = mRowOffsets[i]; k < mRowOffsets[i + 1]; k++)
+            {
+                const Precision value = mValues[k];
+                Precision *pRow = pResult + mColumnIndices[k] * n;
+                for (std::uint64_t j = begin; j < end; j++)
+                {
+                    pRow[j] += value * pRightRow[j];
+                }
+            }
+        }
+    });
+}
+
+size_t SparseMatrix::nonZeros() const
+{
+    return mValues.size();
+}
+
+const SparseMatrix::ShapeVector &SparseMatrix::shape() const
+{
+    return mShape;
+}
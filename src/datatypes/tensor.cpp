@@ -4,7 +4,8 @@
 
 #include "datatypes/tensor.hpp"
 
-std::uint32_t Tensor::calculateIndex(const ShapeVector &rIndex)
+template <typename T>
+std::uint32_t BasicTensor<T>::calculateIndex(const ShapeVector &rIndex)
 {
     if (rIndex.size() != mShape.size())
         throw std::invalid_argument("Tensor::calculateIndex: Index size does not match the dimensionality of the tensor");
@@ -24,25 +25,29 @@ std::uint32_t Tensor::calculateIndex(const ShapeVector &rIndex)
     return index;
 }
 
-Tensor::Tensor(const ShapeVector &dimensionality)
+template <typename T>
+BasicTensor<T>::BasicTensor(const ShapeVector &dimensionality)
 {
-    mData = DataVector(std::accumulate(dimensionality.begin(), dimensionality.end(), 1, std::multiplies<>()), 0);
+    mData = DataVector(std::accumulate(dimensionality.begin(), dimensionality.end(), 1, std::multiplies<>()), static_cast<T>(0));
     mShape = dimensionality;
 }
 
-Tensor::Tensor(const ShapeVector &dimensionality, const Precision &value)
+template <typename T>
+BasicTensor<T>::BasicTensor(const ShapeVector &dimensionality, const Value &value)
 {
     mData = DataVector(std::accumulate(dimensionality.begin(), dimensionality.end(), 1, std::multiplies<>()), value); // initialize the data vector
     mShape = dimensionality;                                                                                                // set the shape of the tensor
 }
 
-Tensor::Tensor(const Tensor &tensor)
+template <typename T>
+BasicTensor<T>::BasicTensor(const BasicTensor &tensor)
 {
     mData = tensor.mData; // copy the data
     mShape = tensor.mShape; // copy the shape
 }
 
-Tensor& Tensor::operator=(const Tensor &tensor)
+template <typename T>
+BasicTensor<T>& BasicTensor<T>::operator=(const BasicTensor &tensor)
 {
     if (this == &tensor)
         return *this;
@@ -51,105 +56,160 @@ Tensor& Tensor::operator=(const Tensor &tensor)
     return *this;
 }
 
-Precision Tensor::at(const ShapeVector &index)
+template <typename T>
+typename BasicTensor<T>::Value BasicTensor<T>::at(const ShapeVector &index)
 {
     return mData[calculateIndex(index)];
 }
 
-Precision Tensor::at(const size_t &index)
+template <typename T>
+typename BasicTensor<T>::Value BasicTensor<T>::at(const size_t &index)
 {
     return mData[index];
 }
 
-void Tensor::set(const ShapeVector &index, const Precision &value)
+template <typename T>
+void BasicTensor<T>::set(const ShapeVector &index, const Value &value)
 {
     mData[calculateIndex(index)] = value;
 }
 
-void Tensor::set(const size_t &index, const Precision &value)
+template <typename T>
+void BasicTensor<T>::set(const size_t &index, const Value &value)
 {
     if (index >= mData.size())
         throw std::out_of_range("Index out of range");
     mData[index] = value;
 }
 
-void Tensor::add(const ShapeVector &index, const Precision &value)
+template <typename T>
+void BasicTensor<T>::add(const ShapeVector &index, const Value &value)
 {
     mData[calculateIndex(index)] += value;
 }
 
-void Tensor::add(const size_t &index, const Precision &value)
+template <typename T>
+void BasicTensor<T>::add(const size_t &index, const Value &value)
 {
     if (index >= mData.size())
         throw std::out_of_range("Index out of range");
     mData[index] += value;
 }
 
-void Tensor::subtract(const ShapeVector &index, const Precision &value)
+template <typename T>
+void BasicTensor<T>::subtract(const ShapeVector &index, const Value &value)
 {
     mData[calculateIndex(index)] -= value;
 }
 
-void Tensor::subtract(const size_t &index, const Precision &value)
+template <typename T>
+void BasicTensor<T>::subtract(const size_t &index, const Value &value)
 {
     mData[index] -= value;
 }
 
-void Tensor::multiply(const ShapeVector &index, const Precision &value)
+template <typename T>
+void BasicTensor<T>::multiply(const ShapeVector &index, const Value &value)
 {
     mData[calculateIndex(index)] *= value;
 }
 
-void Tensor::multiply(const size_t &index, const Precision &value)
+template <typename T>
+void BasicTensor<T>::multiply(const size_t &index, const Value &value)
 {
     if (index >= mData.size())
         throw std::out_of_range("Index out of range");
     mData[index] *= value;
 }
 
-void Tensor::divide(const ShapeVector &index, const Precision &value)
+template <typename T>
+void BasicTensor<T>::divide(const ShapeVector &index, const Value &value)
 {
     mData[calculateIndex(index)] /= value;
 }
 
-void Tensor::divide(const size_t &index, const Precision &value)
+template <typename T>
+void BasicTensor<T>::divide(const size_t &index, const Value &value)
 {
     if (index >= mData.size())
         throw std::out_of_range("Index out of range");
     mData[index] /= value;
 }
 
-typename Tensor::ShapeVector Tensor::shape()
+template <typename T>
+typename BasicTensor<T>::ShapeVector BasicTensor<T>::shape()
 {
     return mShape;
 }
 
-size_t Tensor::shape(const size_t &index) const
+template <typename T>
+size_t BasicTensor<T>::shape(const size_t &index) const
 {
     if (index >= mShape.size())
         throw std::out_of_range("Tensor::shape: Index out of range");
     return mShape[index]; // return the shape at the given index
 }
 
-std::uint32_t Tensor::dimensionality() const
+template <typename T>
+std::uint32_t BasicTensor<T>::dimensionality() const
 {
     return mShape.size(); // return the dimensionality
 }
 
-std::uint32_t Tensor::capacity()
+template <typename T>
+std::uint32_t BasicTensor<T>::capacity()
 {
     return mData.size(); // return the capacity
 }
 
-void Tensor::resize(const ShapeVector &dimensionality)
+template <typename T>
+void BasicTensor<T>::resize(const ShapeVector &dimensionality)
 {
     mData.resize(std::accumulate(dimensionality.begin(), dimensionality.end(), 1, std::multiplies<>())); // resize the data vector
     mShape = dimensionality;                                                                                   // set the new shape
 }
 
-void Tensor::reshape(const ShapeVector &dimensionality)
+template <typename T>
+void BasicTensor<T>::reshape(const ShapeVector &dimensionality)
 {
     if (std::accumulate(dimensionality.begin(), dimensionality.end(), 1, std::multiplies<>()) != mData.size())
         throw std::invalid_argument("Tensor::reshape: New dimensionality does not match the capacity of the tensor");
     mShape = dimensionality; // set the new shape
-}
\ No newline at end of file
+}
+
+template <typename T>
+T *BasicTensor<T>::data()
+{
+    return mData.data();
+}
+
+template <typename T>
+const T *BasicTensor<T>::data() const
+{
+    return mData.data();
+}
+
+template <typename T>
+BasicTensor<T> BasicTensor<T>::permute(const ShapeVector &axes) const
+{
+    BasicTensor result(Transpose::permutedShape(mShape, axes));
+    Transpose::permute(mData.data(), result.mData.data(), mShape, axes);
+    return result;
+}
+
+template <typename T>
+BasicTensor<T> BasicTensor<T>::transpose() const
+{
+    if (mShape.size() < 2)
+        throw std::invalid_argument("Tensor::transpose: The tensor needs at least two dimensions");
+    ShapeVector axes(mShape.size());
+    std::iota(axes.begin(), axes.end(), 0);
+    std::swap(axes[axes.size() - 2], axes[axes.size() - 1]);
+    return permute(axes);
+}
+
+// the element types tensors can be created with
+template class BasicTensor<float>;
+template class BasicTensor<double>;
+template class BasicTensor<BFloat16>;
+template class BasicTensor<Float16>;
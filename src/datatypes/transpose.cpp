@@ -0,0 +1,308 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "datatypes/transpose.hpp"
+#include "parallel.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+#if defined(__AVX__)
+    /**
+     * @brief transpose an 8x8 block of floats in registers
+     */
+    inline void transpose8x8(const float *src, const std::uint64_t srcStride, float *dst, const std::uint64_t dstStride)
+    {
+        __m256 r[8];
+        for (std::uint32_t i = 0; i < 8; i++)
+        {
+            r[i] = _mm256_loadu_ps(src + i * srcStride);
+        }
+
+        // interleave pairs of rows, then pairs of pairs, then swap the 128 bit halves
+        __m256 t[8];
+        for (std::uint32_t i = 0; i < 8; i += 2)
+        {
+            t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+            t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+        }
+        __m256 s[8];
+        for (std::uint32_t i = 0; i < 8; i += 4)
+        {
+            s[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+            s[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+            s[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+            s[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+        }
+        for (std::uint32_t i = 0; i < 4; i++)
+        {
+            _mm256_storeu_ps(dst + i * dstStride, _mm256_permute2f128_ps(s[i], s[i + 4], 0x20));
+            _mm256_storeu_ps(dst + (i + 4) * dstStride, _mm256_permute2f128_ps(s[i], s[i + 4], 0x31));
+        }
+    }
+#endif
+
+    /**
+     * @brief row-major strides of a shape
+     */
+    std::vector<size_t> stridesOf(const std::vector<size_t> &shape)
+    {
+        std::vector<size_t> strides(shape.size(), 1);
+        for (size_t i = shape.size(); i > 1; i--)
+        {
+            strides[i - 2] = strides[i - 1] * shape[i - 1];
+        }
+        return strides;
+    }
+}
+
+template <typename T>
+void Transpose::tile(const T *src, const std::uint64_t srcStride, T *dst, const std::uint64_t dstStride, const std::uint64_t rows, const std::uint64_t cols)
+{
+    std::uint64_t i = 0;
+#if defined(__AVX__)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        for (; i + 8 <= rows; i += 8)
+        {
+            std::uint64_t j = 0;
+            for (; j + 8 <= cols; j += 8)
+            {
+                transpose8x8(src + i * srcStride + j, srcStride, dst + j * dstStride + i, dstStride);
+            }
+            for (; j < cols; j++) // remaining columns of the 8 rows
+            {
+                for (std::uint64_t k = i; k < i + 8; k++)
+                {
+                    dst[j * dstStride + k] = src[k * srcStride + j];
+                }
+            }
+        }
+    }
+#endif
+    for (; i < rows; i++)
+    {
+        for (std::uint64_t j = 0; j < cols; j++)
+        {
+            dst[j * dstStride + i] = src[i * srcStride + j];
+        }
+    }
+}
+
+template <typename T>
+void Transpose::recursive(const T *src, const std::uint64_t srcStride, T *dst, const std::uint64_t dstStride, const std::uint64_t rows, const std::uint64_t cols)
+{
+    if (rows <= msTileSize && cols <= msTileSize)
+    {
+        tile(src, srcStride, dst, dstStride, rows, cols);
+        return;
+    }
+    if (rows >= cols)
+    {
+        const std::uint64_t half = rows / 2 / 8 * 8; // keep the split on 8 element boundaries for the vector blocks
+        recursive(src, srcStride, dst, dstStride, half, cols);
+        recursive(src + half * srcStride, srcStride, dst + half, dstStride, rows - half, cols);
+    }
+    else
+    {
+        const std::uint64_t half = cols / 2 / 8 * 8;
+        recursive(src, srcStride, dst, dstStride, rows, half);
+        recursive(src + half, srcStride, dst + half * dstStride, dstStride, rows, cols - half);
+    }
+}
+
+template <typename T>
+void Transpose::strided(const T *src, const std::uint64_t srcStride, T *dst, const std::uint64_t dstStride, const std::uint64_t rows, const std::uint64_t cols)
+{
+    recursive(src, srcStride, dst, dstStride, rows, cols);
+}
+
+template <typename T>
+void Transpose::matrix(const T *src, T *dst, const std::uint64_t rows, const std::uint64_t cols)
+{
+    permute(src, dst, {rows, cols}, {1, 0});
+}
+
+template <typename T>
+void Transpose::permute(const T *src, T *dst, const ShapeVector &shape, const ShapeVector &axes)
+{
+    if (axes.size() != shape.size())
+    {
+        throw std::invalid_argument("Transpose::permute: The number of axes does not match the dimensionality.");
+    }
+    ShapeVector sorted = axes;
+    std::ranges::sort(sorted);
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        if (sorted[i] != i)
+        {
+            throw std::invalid_argument("Transpose::permute: The axes are not a permutation.");
+        }
+    }
+    const std::uint64_t size = std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies<>());
+    if (size == 0)
+    {
+        return;
+    }
+
+    // simplify the permutation: axes of size 1 do not change the layout,
+    // and source axes that stay neighbours in the result can be merged into one
+    ShapeVector compact(shape.size(), 0); // new index of every kept source axis
+    ShapeVector kept;
+    for (size_t i = 0; i < shape.size(); i++)
+    {
+        compact[i] = kept.size();
+        if (shape[i] != 1)
+        {
+            kept.push_back(i);
+        }
+    }
+    ShapeVector order; // the permutation over the kept axes
+    for (const size_t axis : axes)
+    {
+        if (shape[axis] != 1)
+        {
+            order.push_back(compact[axis]);
+        }
+    }
+    std::vector<ShapeVector> groups; // runs of consecutive source axes, in result order
+    for (const size_t axis : order)
+    {
+        if (!groups.empty() && groups.back().back() + 1 == axis)
+        {
+            groups.back().push_back(axis);
+        }
+        else
+        {
+            groups.push_back({axis});
+        }
+    }
+    std::vector<ShapeVector> sourceGroups = groups; // the groups in source order are the merged source axes
+    std::ranges::sort(sourceGroups);
+    ShapeVector mergedShape(sourceGroups.size(), 1);
+    for (size_t g = 0; g < sourceGroups.size(); g++)
+    {
+        for (const size_t axis : sourceGroups[g])
+        {
+            mergedShape[g] *= shape[kept[axis]];
+        }
+    }
+    ShapeVector perm; // the merged permutation, result axis -> merged source axis
+    for (const ShapeVector &group : groups)
+    {
+        perm.push_back(std::ranges::lower_bound(sourceGroups, group) - sourceGroups.begin());
+    }
+
+    if (perm.size() <= 1 || std::ranges::is_sorted(perm)) // the layout does not change
+    {
+        std::copy(src, src + size, dst);
+        return;
+    }
+
+    const size_t n = mergedShape.size();
+    const ShapeVector srcStrides = stridesOf(mergedShape);
+    const ShapeVector dstShape = permutedShape(mergedShape, perm);
+    const ShapeVector dstStridesByPosition = stridesOf(dstShape);
+    ShapeVector dstStrides(n); // stride in the result of every merged source axis
+    for (size_t i = 0; i < n; i++)
+    {
+        dstStrides[perm[i]] = dstStridesByPosition[i];
+    }
+
+    const size_t a = n - 1;     // contiguous axis of the source
+    const size_t b = perm.back(); // contiguous axis of the result
+    ShapeVector others;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (i != a && i != b)
+        {
+            others.push_back(i);
+        }
+    }
+    const std::uint64_t outer = std::accumulate(others.begin(), others.end(), size_t{1}, [&](const size_t product, const size_t axis) { return product * mergedShape[axis]; });
+
+    // offsets of the plane (or row) with the given flat index over the other axes
+    auto offsets = [&](std::uint64_t index, std::uint64_t &srcOffset, std::uint64_t &dstOffset) {
+        srcOffset = 0;
+        dstOffset = 0;
+        for (size_t k = others.size(); k > 0; k--)
+        {
+            const size_t axis = others[k - 1];
+            const std::uint64_t position = index % mergedShape[axis];
+            index /= mergedShape[axis];
+            srcOffset += position * srcStrides[axis];
+            dstOffset += position * dstStrides[axis];
+        }
+    };
+
+    if (a == b) // the last axis stays last, the permutation moves whole rows
+    {
+        const std::uint64_t length = mergedShape[a];
+        Parallel::forRange(outer, size, [&](const std::uint64_t begin, const std::uint64_t end) {
+            for (std::uint64_t o = begin; o < end; o++)
+            {
+                std::uint64_t srcOffset, dstOffset;
+                offsets(o, srcOffset, dstOffset);
+                std::copy(src + srcOffset, src + srcOffset + length, dst + dstOffset);
+            }
+        });
+        return;
+    }
+
+    // every combination of the other axes is a 2D transpose of axes (b, a) into (a, b), split into bands of rows
+    const std::uint64_t rows = mergedShape[b];
+    const std::uint64_t cols = mergedShape[a];
+    const std::uint64_t bands = (rows + msBandSize - 1) / msBandSize;
+    Parallel::forRange(outer * bands, size, [&](const std::uint64_t begin, const std::uint64_t end) {
+        for (std::uint64_t item = begin; item < end; item++)
+        {
+            std::uint64_t srcOffset, dstOffset;
+            offsets(item / bands, srcOffset, dstOffset);
+            const std::uint64_t first = item % bands * msBandSize;
+            const std::uint64_t count = std::min(msBandSize, rows - first);
+            recursive(src + srcOffset + first * srcStrides[b], srcStrides[b], dst + dstOffset + first, dstStrides[a], count, cols);
+        }
+    });
+}
+
+Transpose::ShapeVector Transpose::permutedShape(const ShapeVector &shape, const ShapeVector &axes)
+{
+    if (axes.size() != shape.size())
+    {
+        throw std::invalid_argument("Transpose::permutedShape: The number of axes does not match the dimensionality.");
+    }
+    ShapeVector result(axes.size());
+    for (size_t i = 0; i < axes.size(); i++)
+    {
+        result[i] = shape.at(axes[i]);
+    }
+    return result;
+}
+
+Transpose::ShapeVector Transpose::inverse(const ShapeVector &axes)
+{
+    ShapeVector result(axes.size());
+    for (size_t i = 0; i < axes.size(); i++)
+    {
+        result.at(axes[i]) = i;
+    }
+    return result;
+}
+
+// the element types tensors can be created with
+template void Transpose::matrix(const float *, float *, std::uint64_t, std::uint64_t);
+template void Transpose::matrix(const double *, double *, std::uint64_t, std::uint64_t);
+template void Transpose::matrix(const BFloat16 *, BFloat16 *, std::uint64_t, std::uint64_t);
+template void Transpose::matrix(const Float16 *, Float16 *, std::uint64_t, std::uint64_t);
+template void Transpose::strided(const float *, std::uint64_t, float *, std::uint64_t, std::uint64_t, std::uint64_t);
+template void Transpose::strided(const double *, std::uint64_t, double *, std::uint64_t, std::uint64_t, std::uint64_t);
+template void Transpose::strided(const BFloat16 *, std::uint64_t, BFloat16 *, std::uint64_t, std::uint64_t, std::uint64_t);
+template void Transpose::strided(const Float16 *, std::uint64_t, Float16 *, std::uint64_t, std::uint64_t, std::uint64_t);
+template void Transpose::permute(const float *, float *, const ShapeVector &, const ShapeVector &);
+template void Transpose::permute(const double *, double *, const ShapeVector &, const ShapeVector &);
+template void Transpose::permute(const BFloat16 *, BFloat16 *, const ShapeVector &, const ShapeVector &);
+template void Transpose::permute(const Float16 *, Float16 *, const ShapeVector &, const ShapeVector &);
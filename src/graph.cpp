@@ -56,11 +56,22 @@ std::vector<std::shared_ptr<Variable>> Graph::mTopologicalSort( std::vector<Vari
 
 void Graph::forward(std::vector<VariablePtr> & inputVariables) const
 {
-    for (std::vector<VariablePtr> pSorted = mTopologicalSort( inputVariables ); const VariablePtr& var : pSorted)
+    execute(mTopologicalSort( inputVariables ));
+}
+
+std::vector<std::shared_ptr<Variable>> Graph::getTopologicalOrder(std::vector<VariablePtr> & inputVariables) const
+{
+    return mTopologicalSort(inputVariables);
+}
+
+void Graph::execute(const std::vector<VariablePtr> & sortedVariables)
+{
+    for (const VariablePtr& var : sortedVariables)
     {
         if (var->getOperation() != nullptr) // if the variable has an operation, execute it
         {
             var->getOperation()->f(var->getInputs()); // execute the operation
+            var->bumpVersion();
         }
     }
 }
@@ -86,6 +97,41 @@ void Graph::backprop(std::vector<VariablePtr> & targetVariables, std::vector<Var
     }
 }
 
+void Graph::seedLeaves(GradTable & gradTable, const std::vector<VariablePtr> & leafVariables, const std::vector<VariablePtr> & lossVariables, const double leafInitValue, const std::uint32_t parts)
+{
+    for (const VariablePtr& pLeaf : leafVariables)
+    {
+        // the surrogate losses are differentiated per row, so the parts add up to the batch,
+        // the other leafs (e.g. norms) do not depend on the rows and count once per batch
+        const bool loss = std::ranges::find(lossVariables, pLeaf) != lossVariables.end();
+        gradTable[pLeaf] = std::make_shared<Tensor>(Tensor(pLeaf->getData()->shape(), loss ? leafInitValue : leafInitValue / parts));
+    }
+}
+
+std::vector<std::shared_ptr<Tensor>> Graph::computeGradients(const std::vector<VariablePtr> & targetVariables, GradTable & gradTable)
+{
+    std::vector<std::shared_ptr<Tensor>> gradients;
+    for (const VariablePtr& pVar : targetVariables)
+    {
+        mBuildGrad(pVar, gradTable);
+        gradients.push_back(gradTable[pVar]);
+    }
+    return gradients;
+}
+
+void Graph::setGradients(const std::vector<VariablePtr> & variables, const std::vector<std::shared_ptr<Tensor>> & gradients)
+{
+    if (variables.size() != gradients.size())
+    {
+        throw std::invalid_argument("Graph::setGradients: Every variable needs a gradient.");
+    }
+    mGradTable.clear();
+    for (size_t i = 0; i < variables.size(); i++)
+    {
+        mGradTable[variables[i]] = gradients[i];
+    }
+}
+
 void Graph::mBuildGrad(VariablePtr pFocus, GradTable & gradTable) // NOLINT
 {
     // error handling
@@ -0,0 +1,78 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "graph_replica.hpp"
+
+GraphReplica::GraphReplica(std::vector<VariablePtr> &graphInputs, const std::vector<VariablePtr> &learnableVariables, const std::vector<VariablePtr> &gradientVariables, const std::vector<VariablePtr> &lossVariables)
+{
+    const std::vector<VariablePtr> order = GRAPH->getTopologicalOrder(graphInputs);
+    pData = GRAPH->addVariable(std::make_shared<Variable>(Variable(nullptr)));
+    pLabels = GRAPH->addVariable(std::make_shared<Variable>(Variable(nullptr)));
+    std::map<VariablePtr, VariablePtr> copies = {{graphInputs[0], pData}, {graphInputs[1], pLabels}};
+
+    for (const VariablePtr &pVar : order)
+    {
+        if (copies.contains(pVar))
+        {
+            continue;
+        }
+        if (pVar->getOperation() == nullptr) // a parameter, its data is handed over by share
+        {
+            copies[pVar] = GRAPH->addVariable(std::make_shared<Variable>(Variable(nullptr)));
+            continue;
+        }
+        copies[pVar] = GRAPH->addVariable(std::make_shared<Variable>(Variable(pVar->getOperation()->clone())));
+        variables.push_back(copies[pVar]);
+    }
+
+    // the same connections, in the same order, between the copies
+    for (const auto &[pVar, pCopy] : copies)
+    {
+        for (const VariablePtr &pInput : pVar->getInputs())
+        {
+            if (!copies.contains(pInput))
+            {
+                throw std::invalid_argument("GraphReplica::GraphReplica: A variable of the model depends on a variable outside of the model.");
+            }
+            pCopy->getInputs().push_back(copies[pInput]);
+        }
+        for (const VariablePtr &pConsumer : pVar->getConsumers())
+        {
+            if (copies.contains(pConsumer))
+            {
+                pCopy->getConsumers().push_back(copies[pConsumer]);
+            }
+        }
+    }
+
+    auto translate = [&](const std::vector<VariablePtr> &model, std::vector<VariablePtr> &result) {
+        for (const VariablePtr &pVar : model)
+        {
+            if (copies.contains(pVar))
+            {
+                result.push_back(copies[pVar]);
+            }
+        }
+    };
+    translate(learnableVariables, learnables);
+    translate(gradientVariables, leaves);
+    translate(lossVariables, losses);
+    if (learnables.size() != learnableVariables.size() || losses.size() != lossVariables.size())
+    {
+        throw std::invalid_argument("GraphReplica::GraphReplica: The parameters and the loss must be reachable from the dataset.");
+    }
+    versions.assign(learnableVariables.size(), std::numeric_limits<std::uint64_t>::max());
+}
+
+void GraphReplica::share(const std::vector<VariablePtr> &learnableVariables)
+{
+    for (size_t k = 0; k < learnableVariables.size(); k++)
+    {
+        if (learnableVariables[k]->getOperation() == nullptr && versions[k] != learnableVariables[k]->getVersion())
+        {
+            learnables[k]->setData(learnableVariables[k]->getData());
+            versions[k] = learnableVariables[k]->getVersion();
+        }
+    }
+}
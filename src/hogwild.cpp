@@ -0,0 +1,143 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "hogwild.hpp"
+
+Hogwild::Hogwild(const std::uint32_t workers) :
+mWorkerCount(workers),
+mCoresPerWorker(ThreadTeam::coreShare(workers)),
+mTeam(workers, mCoresPerWorker)
+{
+}
+
+std::vector<std::vector<double>> Hogwild::epoch(Dataset &dataset, const std::uint32_t batchSize, std::vector<VariablePtr> &graphInputs, const std::vector<VariablePtr> &learnableVariables, const std::vector<VariablePtr> &gradientVariables, const std::vector<VariablePtr> &lossVariables, OptimizerVariant &optimizer)
+{
+    if (dataset.isStreamed())
+    {
+        // the workers read the batches concurrently and out of order
+        throw std::invalid_argument("Hogwild::epoch: A streamed training set can not be trained asynchronously.");
+    }
+    const std::uint32_t batches = dataset.trainingBatchCount(batchSize);
+    if (batches == 0)
+    {
+        return {};
+    }
+    if (mModelLearnables != learnableVariables)
+    {
+        mReplicas.clear();
+        for (std::uint32_t w = 0; w < mWorkerCount; w++)
+        {
+            mReplicas.emplace_back(graphInputs, learnableVariables, gradientVariables, lossVariables);
+        }
+        mModelLearnables = learnableVariables;
+    }
+    std::visit([&]<typename T>(T &arg) {
+        if constexpr (std::is_same_v<T, Momentum>)
+        {
+            arg.init(learnableVariables); // the velocity is shared, it must exist before the workers start
+        }
+    }, optimizer);
+
+    std::vector<std::vector<double>> losses(batches, std::vector<double>(lossVariables.size(), 0));
+    std::vector<double> busySeconds(mWorkerCount, 0);
+    std::vector<double> staleness(mWorkerCount, 0);
+    std::vector<std::uint64_t> updates(mWorkerCount, 0);
+    std::atomic<std::uint32_t> nextBatch = 0;
+    std::atomic<std::uint64_t> appliedUpdates = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    mTeam.run([&](const std::uint32_t w) {
+        GraphReplica &replica = mReplicas[w];
+        Parallel::setLocalThreadCount(mCoresPerWorker);
+        replica.share(learnableVariables);
+        const auto begin = std::chrono::steady_clock::now();
+
+        std::shared_ptr<Tensor> data;
+        std::shared_ptr<Tensor> labels;
+        for (std::uint32_t batch = nextBatch.fetch_add(1, std::memory_order_relaxed); batch < batches; batch = nextBatch.fetch_add(1, std::memory_order_relaxed))
+        {
+            dataset.gatherTrainingBatch(batch * batchSize, batchSize, data, labels);
+            replica.pData->setData(data);
+            replica.pLabels->setData(labels);
+            std::vector<VariablePtr> targets;
+            for (size_t k = 0; k < learnableVariables.size(); k++)
+            {
+                if (learnableVariables[k]->getOperation() == nullptr)
+                {
+                    replica.learnables[k]->bumpVersion(); // the other workers changed the shared tensors, e.g. packed weights are stale
+                    targets.push_back(replica.learnables[k]);
+                }
+            }
+            const std::uint64_t seen = appliedUpdates.load(std::memory_order_relaxed);
+
+            Graph::execute(replica.variables);
+            for (size_t k = 0; k < replica.losses.size(); k++)
+            {
+                losses[batch][k] = replica.losses[k]->getData()->at(0);
+            }
+            Graph::GradTable gradTable;
+            for (const VariablePtr &pLeaf : replica.leaves)
+            {
+                gradTable[pLeaf] = std::make_shared<Tensor>(Tensor(pLeaf->getData()->shape(), 1.0 / batchSize));
+            }
+            const std::vector<std::shared_ptr<Tensor>> computed = Graph::computeGradients(targets, gradTable);
+
+            std::vector<std::shared_ptr<Tensor>> gradients(learnableVariables.size(), nullptr);
+            for (size_t k = 0, t = 0; k < learnableVariables.size(); k++)
+            {
+                if (learnableVariables[k]->getOperation() == nullptr)
+                {
+                    gradients[k] = computed[t++];
+                }
+            }
+            std::visit([&](auto &&arg) { arg.updateShared(learnableVariables, gradients); }, optimizer);
+            staleness[w] += static_cast<double>(appliedUpdates.fetch_add(1, std::memory_order_relaxed) - seen);
+            updates[w]++;
+        }
+        busySeconds[w] = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    });
+    mWallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    mBusySeconds += std::accumulate(busySeconds.begin(), busySeconds.end(), 0.0);
+    mStaleness += std::accumulate(staleness.begin(), staleness.end(), 0.0);
+    mUpdates += std::accumulate(updates.begin(), updates.end(), std::uint64_t(0));
+    mExamples += static_cast<std::uint64_t>(batches) * batchSize;
+
+    for (const VariablePtr &pVar : learnableVariables) // the tensors were changed in place
+    {
+        if (pVar->getOperation() == nullptr)
+        {
+            pVar->bumpVersion();
+        }
+    }
+    return losses;
+}
+
+std::uint32_t Hogwild::workerCount() const
+{
+    return mWorkerCount;
+}
+
+double Hogwild::examplesPerSecond() const
+{
+    return mWallSeconds == 0 ? 0 : static_cast<double>(mExamples) / mWallSeconds;
+}
+
+double Hogwild::meanStaleness() const
+{
+    return mUpdates == 0 ? 0 : mStaleness / static_cast<double>(mUpdates);
+}
+
+double Hogwild::efficiency() const
+{
+    return mWallSeconds == 0 ? 0 : mBusySeconds / (mWorkerCount * mWallSeconds);
+}
+
+void Hogwild::resetStatistics()
+{
+    mBusySeconds = 0;
+    mWallSeconds = 0;
+    mStaleness = 0;
+    mUpdates = 0;
+    mExamples = 0;
+}
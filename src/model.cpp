@@ -32,6 +32,149 @@ bool Model::earlyStopping(const std::uint32_t &epoch, std::uint32_t &bestEpoch,
 }
 
 
+void Model::createWeights(Dataset &dataset, std::vector<std::shared_ptr<Variable>> &graphInputs, const std::uint32_t batchSize) const
+{
+    if (std::ranges::none_of(mLearnableVariables, [](const std::shared_ptr<Variable> &pVar) { return pVar->getData() == nullptr; }))
+    {
+        return;
+    }
+    if (graphInputs[0]->getData() == nullptr) // nothing loaded yet, the asynchronous trainers gather their own batches
+    {
+        std::shared_ptr<Tensor> data;
+        std::shared_ptr<Tensor> labels;
+        dataset.gatherTrainingBatch(0, batchSize, data, labels);
+        graphInputs[0]->setData(data);
+        graphInputs[1]->setData(labels);
+    }
+    GRAPH->forward(graphInputs); // the weights are created by the first forward pass, their shape depends on the input
+}
+
+bool Model::trainingStep(std::vector<std::shared_ptr<Variable>> &graphInputs, OptimizerVariant &optimizer, const std::uint32_t batchSize)
+{
+    const double scale = mLossScaling ? mLossScaler.scale() : 1.0;
+    if (mpDataParallel != nullptr)
+    {
+        mpDataParallel->step(graphInputs, mLearnableVariables, mGradientVariables, mLossVariables, scale/batchSize); // forward and backward pass of the replicas
+    }
+    else if (mpPipeline != nullptr)
+    {
+        mpPipeline->step(mModules, graphInputs, mLearnableVariables, mGradientVariables, mLossVariables, scale/batchSize); // forward and backward pass of the micro-batches
+    }
+    else
+    {
+        GRAPH->forward(graphInputs); // forward pass
+        GRAPH->backprop( mLearnableVariables, mGradientVariables, scale/batchSize); // backward pass
+    }
+
+    if (mLossScaling && !mLossScaler.unscale(mLearnableVariables)) // overflow, skip the update
+    {
+        return false;
+    }
+    std::visit([&](auto&& arg) {
+        arg.update(mLearnableVariables); }, optimizer); // update parameters
+    return true;
+}
+
+double Model::trainingEpoch(Dataset &dataset, std::vector<std::shared_ptr<Variable>> &graphInputs, OptimizerVariant &optimizer, const std::uint32_t batchSize)
+{
+    if (mpHogwild != nullptr || mpParameterServer != nullptr)
+    {
+        if (mLossScaling)
+        {
+            throw std::invalid_argument("Model::trainingEpoch: Asynchronous training does not support loss scaling.");
+        }
+        createWeights(dataset, graphInputs, batchSize);
+        const std::vector<std::vector<double>> losses = mpHogwild != nullptr
+            ? mpHogwild->epoch(dataset, batchSize, graphInputs, mLearnableVariables, mGradientVariables, mLossVariables, optimizer)
+            : mpParameterServer->epoch(dataset, batchSize, graphInputs, mLearnableVariables, mGradientVariables, mLossVariables, optimizer);
+
+        double trainingSurrogateLoss = 0;
+        for (const std::vector<double> &batch : losses) // the statistics of all workers in the order of the batches
+        {
+            trainingSurrogateLoss += batch[1];
+            Logger::logIteration(batch[0], batch[1]);
+        }
+        return trainingSurrogateLoss / losses.size();
+    }
+
+    std::uint32_t iteration = 0;
+    double trainingSurrogateLoss = 0;
+    while (dataset.goodTrainingBatch(batchSize))
+    {
+        dataset.loadTrainingBatch(batchSize);
+        createWeights(dataset, graphInputs, batchSize);
+
+        if (!trainingStep(graphInputs, optimizer, batchSize)) // overflow, the step did not count
+        {
+            continue;
+        }
+        iteration++;
+
+        // log and store results
+        const double loss = mLossVariables[0]->getData()->at(0);
+        const double surrogateLoss = mLossVariables[1]->getData()->at(0);
+
+        trainingSurrogateLoss += surrogateLoss;
+
+        Logger::logIteration(loss, surrogateLoss);
+    }
+    if (iteration == 0) // every step overflowed
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return trainingSurrogateLoss / iteration;
+}
+
+void Model::setLossScaling(const bool enabled, const LossScaler &lossScaler)
+{
+    mLossScaling = enabled;
+    mLossScaler = lossScaler;
+}
+
+void Model::setPipeline(const std::uint32_t stages, const std::uint32_t microBatches)
+{
+    if (stages > 1 && mpDataParallel != nullptr)
+    {
+        throw std::invalid_argument("Model::setPipeline: Pipeline and data parallelism can not be combined.");
+    }
+    if (stages > 1 && (mpHogwild != nullptr || mpParameterServer != nullptr))
+    {
+        throw std::invalid_argument("Model::setPipeline: Pipeline parallelism and asynchronous training can not be combined.");
+    }
+    mpPipeline = stages > 1 ? std::make_shared<Pipeline>(stages, microBatches) : nullptr;
+}
+
+void Model::setDataParallel(const std::uint32_t replicas)
+{
+    if (replicas > 1 && mpPipeline != nullptr)
+    {
+        throw std::invalid_argument("Model::setDataParallel: Pipeline and data parallelism can not be combined.");
+    }
+    if (replicas > 1 && (mpHogwild != nullptr || mpParameterServer != nullptr))
+    {
+        throw std::invalid_argument("Model::setDataParallel: Data parallelism and asynchronous training can not be combined.");
+    }
+    mpDataParallel = replicas > 1 ? std::make_shared<DataParallel>(replicas) : nullptr;
+}
+
+void Model::setHogwild(const std::uint32_t workers)
+{
+    if (workers > 1 && (mpPipeline != nullptr || mpDataParallel != nullptr || mpParameterServer != nullptr))
+    {
+        throw std::invalid_argument("Model::setHogwild: Asynchronous training can not be combined with other parallel training.");
+    }
+    mpHogwild = workers > 1 ? std::make_shared<Hogwild>(workers) : nullptr;
+}
+
+void Model::setParameterServer(const std::uint32_t workers, const std::uint32_t staleness)
+{
+    if (workers > 0 && (mpPipeline != nullptr || mpDataParallel != nullptr || mpHogwild != nullptr))
+    {
+        throw std::invalid_argument("Model::setParameterServer: Worker processes can not be combined with other parallel training.");
+    }
+    mpParameterServer = workers > 0 ? std::make_shared<ParameterServer>(workers, staleness) : nullptr;
+}
+
 std::shared_ptr<Module> Model::addModule(const ModuleVariant &module)
 {
     const std::shared_ptr<Module> pModule = std::visit([]<typename T0>(T0&& arg) {
@@ -104,27 +247,7 @@ void Model::train(Dataset &dataset, const std::string& inputModule, const std::s
     {
         dataset.shuffleTrainingSet();
 
-        std::uint32_t iteration = 0;
-        double trainingSurrogateLoss = 0;
-        while (dataset.goodTrainingBatch(batchSize))
-        {
-            iteration++;
-            dataset.loadTrainingBatch(batchSize);
-
-            GRAPH->forward(graphInputs); // forward pass
-            GRAPH->backprop( mLearnableVariables, mGradientVariables, static_cast<double>(1)/batchSize); // backward pass
-
-            std::visit([&](auto&& arg) {
-                arg.update(mLearnableVariables); }, optimizer); // update parameters
-
-            // log and store results
-            const double loss = mLossVariables[0]->getData()->at(0);
-            const double surrogateLoss = mLossVariables[1]->getData()->at(0);
-
-            trainingSurrogateLoss += surrogateLoss;
-
-            Logger::logIteration(loss, surrogateLoss);
-        }
+        const double trainingSurrogateLoss = trainingEpoch(dataset, graphInputs, optimizer, batchSize);
 
         if (dataset.hasValidationSet())
         {
@@ -137,7 +260,7 @@ void Model::train(Dataset &dataset, const std::string& inputModule, const std::s
 
             Logger::logEpoch(validationLoss, validationSurrogateLoss);
 
-            if (earlyStopping(epoch, bestEpoch, earlyStoppingPatience, validationSurrogateLoss, bestValidationSurrogateLoss, bestParameters, trainingSurrogateLoss / iteration, bestTrainingSurrogateLoss))
+            if (earlyStopping(epoch, bestEpoch, earlyStoppingPatience, validationSurrogateLoss, bestValidationSurrogateLoss, bestParameters, trainingSurrogateLoss, bestTrainingSurrogateLoss))
             {
                 break;
             }
@@ -153,34 +276,54 @@ void Model::train(Dataset &dataset, const std::string& inputModule, const std::s
         {
             dataset.shuffleTrainingSet(true); // shuffle complete training set
 
-            std::uint32_t iteration = 0;
-            trainingSurrogateLoss = 0;
-
-            while (dataset.goodTrainingBatch(batchSize))
-            {
-                iteration++;
-                dataset.loadTrainingBatch(batchSize);
-
-                GRAPH->forward(graphInputs); // forward pass
-                GRAPH->backprop( mLearnableVariables, mGradientVariables, static_cast<double>(1)/batchSize); // backward pass
-
-                std::visit([&](auto&& arg) {
-                    arg.update(mLearnableVariables); }, optimizer); // update parameters
-
-                // log and store results
-                const double loss = mLossVariables[0]->getData()->at(0);
-                const double surrogateLoss = mLossVariables[1]->getData()->at(0);
-
-                trainingSurrogateLoss += surrogateLoss;
+            trainingSurrogateLoss = trainingEpoch(dataset, graphInputs, optimizer, batchSize);
+        } while (trainingSurrogateLoss > bestTrainingSurrogateLoss);
+    }
 
-                Logger::logIteration(loss, surrogateLoss);
-            }
+    if (mpPipeline != nullptr)
+    {
+        std::cout << "{\n";
+        std::cout << " \t \"pipeline_stages\": " << mpPipeline->stageCount() << ",\n";
+        std::cout << " \t \"pipeline_micro_batches\": " << mpPipeline->microBatchCount() << ",\n";
+        std::cout << " \t \"pipeline_bubble_seconds\": " << mpPipeline->bubbleSeconds() << ",\n";
+        std::cout << " \t \"pipeline_bubble_fraction\": " << mpPipeline->bubbleFraction() << "\n";
+        std::cout << "}"<< std::endl;
+        mpPipeline->resetStatistics();
+    }
 
-            trainingSurrogateLoss /= iteration;
-        } while (trainingSurrogateLoss > bestTrainingSurrogateLoss);
+    if (mpDataParallel != nullptr)
+    {
+        std::cout << "{\n";
+        std::cout << " \t \"data_parallel_replicas\": " << mpDataParallel->replicaCount() << ",\n";
+        std::cout << " \t \"examples_per_second\": " << mpDataParallel->examplesPerSecond() << ",\n";
+        std::cout << " \t \"allreduce_seconds\": " << mpDataParallel->reduceSeconds() << ",\n";
+        std::cout << " \t \"data_parallel_efficiency\": " << mpDataParallel->efficiency() << "\n";
+        std::cout << "}"<< std::endl;
+        mpDataParallel->resetStatistics();
     }
 
+    if (mpHogwild != nullptr)
+    {
+        std::cout << "{\n";
+        std::cout << " \t \"hogwild_workers\": " << mpHogwild->workerCount() << ",\n";
+        std::cout << " \t \"examples_per_second\": " << mpHogwild->examplesPerSecond() << ",\n";
+        std::cout << " \t \"mean_staleness\": " << mpHogwild->meanStaleness() << ",\n";
+        std::cout << " \t \"hogwild_efficiency\": " << mpHogwild->efficiency() << "\n";
+        std::cout << "}"<< std::endl;
+        mpHogwild->resetStatistics();
+    }
 
+    if (mpParameterServer != nullptr)
+    {
+        std::cout << "{\n";
+        std::cout << " \t \"parameter_server_workers\": " << mpParameterServer->workerCount() << ",\n";
+        std::cout << " \t \"staleness_bound\": " << mpParameterServer->staleness() << ",\n";
+        std::cout << " \t \"examples_per_second\": " << mpParameterServer->examplesPerSecond() << ",\n";
+        std::cout << " \t \"mean_staleness\": " << mpParameterServer->meanStaleness() << ",\n";
+        std::cout << " \t \"megabytes_transferred\": " << mpParameterServer->bytesTransferred() / 1e6 << "\n";
+        std::cout << "}"<< std::endl;
+        mpParameterServer->resetStatistics();
+    }
 
     Variable::disconnectVariables(dataset.getOutputs()[0], mModuleMap[inputModule]->getInputs()[0]);
     Variable::disconnectVariables(dataset.getOutputs()[1], mModuleMap[lossModule]->getInputs()[0]);
@@ -212,4 +355,66 @@ void Model::test(Dataset &dataset, const std::string& inputModule, const std::st
     Variable::disconnectVariables(dataset.getOutputs()[0], mModuleMap[inputModule]->getInputs()[0]);
     Variable::disconnectVariables(dataset.getOutputs()[1], mModuleMap[lossModule]->getInputs()[0]);
     Variable::disconnectVariables(dataset.getOutputs()[1], mModuleMap[lossModule]->getInputs()[1]);
-}
\ No newline at end of file
+}
+
+void Model::quantize(Dataset &dataset, const std::string& inputModule, const std::string& lossModule, const std::uint32_t calibrationSize)
+{
+    Dropout::activateAveraging();
+
+    Variable::connectVariables(dataset.getOutputs()[0], mModuleMap[inputModule]->getInputs()[0]);
+    Variable::connectVariables(dataset.getOutputs()[1], mModuleMap[lossModule]->getInputs()[0]);
+    Variable::connectVariables(dataset.getOutputs()[1], mModuleMap[lossModule]->getInputs()[1]);
+
+    std::vector<std::shared_ptr<Variable>> graphInputs = dataset.getOutputs();
+    graphInputs.insert(graphInputs.end(), mLearnableVariables.begin(), mLearnableVariables.end());
+
+    dataset.loadTestSet();
+    GRAPH->forward(graphInputs); // float reference
+    const double floatLoss = mLossVariables[0]->getData()->at(0);
+    const double floatSurrogateLoss = mLossVariables[1]->getData()->at(0);
+
+    dataset.shuffleTrainingSet();
+    dataset.loadTrainingBatch(std::min(calibrationSize, dataset.trainingSetSize()));
+    GRAPH->forward(graphInputs); // calibration, every layer sees the inputs of the float model
+
+    std::uint64_t floatBytes = 0;
+    std::uint64_t quantizedBytes = 0;
+    for (const std::shared_ptr<Module> &module : mModules)
+    {
+        if (const std::shared_ptr<Dense> pDense = std::dynamic_pointer_cast<Dense>(module); pDense != nullptr)
+        {
+            floatBytes += pDense->weightBytes();
+            quantizedBytes += pDense->quantize();
+        }
+    }
+
+    dataset.loadTestSet();
+    GRAPH->forward(graphInputs);
+    const double loss = mLossVariables[0]->getData()->at(0);
+    const double surrogateLoss = mLossVariables[1]->getData()->at(0);
+
+    std::cout << "{\n";
+    std::cout << " \t \"float_test_loss\": " << floatLoss << ",\n";
+    std::cout << " \t \"float_test_surrogate_loss\": " << floatSurrogateLoss << ",\n";
+    std::cout << " \t \"int8_test_loss\": " << loss << ",\n";
+    std::cout << " \t \"int8_test_surrogate_loss\": " << surrogateLoss << ",\n";
+    std::cout << " \t \"test_loss_delta\": " << loss - floatLoss << ",\n";
+    std::cout << " \t \"float_weight_bytes\": " << floatBytes << ",\n";
+    std::cout << " \t \"int8_weight_bytes\": " << quantizedBytes << "\n";
+    std::cout << "}"<< std::endl;
+
+    Variable::disconnectVariables(dataset.getOutputs()[0], mModuleMap[inputModule]->getInputs()[0]);
+    Variable::disconnectVariables(dataset.getOutputs()[1], mModuleMap[lossModule]->getInputs()[0]);
+    Variable::disconnectVariables(dataset.getOutputs()[1], mModuleMap[lossModule]->getInputs()[1]);
+}
+
+void Model::dequantize()
+{
+    for (const std::shared_ptr<Module> &module : mModules)
+    {
+        if (const std::shared_ptr<Dense> pDense = std::dynamic_pointer_cast<Dense>(module); pDense != nullptr)
+        {
+            pDense->dequantize();
+        }
+    }
+}
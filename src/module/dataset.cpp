@@ -3,36 +3,81 @@
 //
 #include "module/dataset.hpp"
 
-Dataset::Dataset(const dataType &trainingData, const dataType &trainingLabels, const double &validationSplit, const Dataset::dataType &testData, const Dataset::dataType &testLabels, const std::string &name) : Module(name)
+Dataset::Dataset(const dataType &trainingData, const dataType &trainingLabels, const double &validationSplit, const Dataset::dataType &testData, const Dataset::dataType &testLabels, const std::string &name) :
+Dataset(SampleStorage(trainingData), SampleStorage(trainingLabels), validationSplit, SampleStorage(testData), SampleStorage(testLabels), name)
+{
+}
+
+Dataset::Dataset(const dataType &trainingData, const dataType &trainingLabels, const dataType &testData, const dataType &testLabels, const std::string &name) :
+Dataset(SampleStorage(trainingData), SampleStorage(trainingLabels), SampleStorage(testData), SampleStorage(testLabels), name)
+{
+}
+
+Dataset::Dataset(const SampleStorage &trainingData, const SampleStorage &trainingLabels, const double &validationSplit, SampleStorage testData, SampleStorage testLabels, const std::string &name) : Module(name)
 {
     if (trainingData.size() != trainingLabels.size()) throw std::runtime_error("data and labels have different sizes");
     if (testData.size() != testLabels.size()) throw std::runtime_error("data and labels have different sizes");
 
-    Preprocessing::splitData(trainingData, trainingLabels, validationSplit, mTrainingData, mValidationData, mTrainingLabels, mValidationLabels);
-    mTestData = testData;
-    mTestLabels = testLabels;
+    std::vector<std::uint32_t> trainingIndices;
+    std::vector<std::uint32_t> validationIndices;
+    Preprocessing::splitIndices(trainingData.size(), validationSplit, trainingIndices, validationIndices);
+    mTrainingData = SampleStorage(trainingData, trainingIndices);
+    mTrainingLabels = SampleStorage(trainingLabels, trainingIndices);
+    mValidationData = SampleStorage(trainingData, validationIndices);
+    mValidationLabels = SampleStorage(trainingLabels, validationIndices);
+    mTestData = std::move(testData);
+    mTestLabels = std::move(testLabels);
 
     mDataVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(nullptr, {}, {})));
     mLabelVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(nullptr, {}, {})));
 }
 
-Dataset::Dataset(const dataType &trainingData, const dataType &trainingLabels, const dataType &testData, const dataType &testLabels, const std::string &name) : Module(name)
+Dataset::Dataset(SampleStorage trainingData, SampleStorage trainingLabels, SampleStorage testData, SampleStorage testLabels, const std::string &name) :
+Dataset(std::move(trainingData), std::move(trainingLabels), {}, {}, std::move(testData), std::move(testLabels), name)
+{
+}
+
+Dataset::Dataset(SampleStorage trainingData, SampleStorage trainingLabels, SampleStorage validationData, SampleStorage validationLabels, SampleStorage testData, SampleStorage testLabels, const std::string &name) : Module(name)
 {
     if (trainingData.size() != trainingLabels.size()) throw std::runtime_error("data and labels have different sizes");
+    if (validationData.size() != validationLabels.size()) throw std::runtime_error("data and labels have different sizes");
+    if (testData.size() != testLabels.size()) throw std::runtime_error("data and labels have different sizes");
+
+    mTrainingData = std::move(trainingData);
+    mTrainingLabels = std::move(trainingLabels);
+    mValidationData = std::move(validationData);
+    mValidationLabels = std::move(validationLabels);
+    mTestData = std::move(testData);
+    mTestLabels = std::move(testLabels);
+
+    mDataVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(nullptr, {}, {})));
+    mLabelVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(nullptr, {}, {})));
+}
+
+Dataset::Dataset(std::shared_ptr<ShardStream> trainingStream, SampleStorage validationData, SampleStorage validationLabels, SampleStorage testData, SampleStorage testLabels, const std::string &name) : Module(name)
+{
+    if (trainingStream == nullptr) throw std::invalid_argument("Dataset::Dataset: The training stream is missing.");
+    if (validationData.size() != validationLabels.size()) throw std::runtime_error("data and labels have different sizes");
     if (testData.size() != testLabels.size()) throw std::runtime_error("data and labels have different sizes");
 
-    mTrainingData = trainingData;
-    mTrainingLabels = trainingLabels;
-    mTestData = testData;
-    mTestLabels = testLabels;
+    mpStream = std::move(trainingStream);
+    mValidationData = std::move(validationData);
+    mValidationLabels = std::move(validationLabels);
+    mTestData = std::move(testData);
+    mTestLabels = std::move(testLabels);
 
     mDataVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(nullptr, {}, {})));
     mLabelVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(nullptr, {}, {})));
 }
 
+std::uint64_t Dataset::mEpochSize() const
+{
+    return mpStream != nullptr ? mpStream->size() : mTrainingIndices.size();
+}
+
 bool Dataset::goodTrainingBatch(const std::uint32_t &batchSize) const
 {
-    return mIndex + batchSize < mTrainingIndices.size();
+    return mIndex + batchSize < mEpochSize();
 }
 
 bool Dataset::hasValidationSet() const
@@ -40,55 +85,183 @@ bool Dataset::hasValidationSet() const
     return !mValidationData.empty();
 }
 
+bool Dataset::isStreamed() const
+{
+    return mpStream != nullptr;
+}
+
+std::uint32_t Dataset::trainingSetSize() const
+{
+    return mpStream != nullptr ? mpStream->size() : mTrainingData.size();
+}
+
 void Dataset::shuffleTrainingSet(const bool completeTrainingSet)
 {
+    if (mpPrefetcher != nullptr)
+    {
+        mpPrefetcher->stop(); // it reads the order
+    }
+    mIndex = 0;
+    if (mpStream != nullptr)
+    {
+        mpStream->start();
+        return;
+    }
     mTrainingIndices.resize(mTrainingData.size() + (completeTrainingSet ? mValidationData.size() : 0));
     std::iota(mTrainingIndices.begin(), mTrainingIndices.end(), 0);
-    std::ranges::shuffle(mTrainingIndices, std::mt19937(std::random_device()()));
-
-    mIndex = 0;
+    std::ranges::shuffle(mTrainingIndices, mShuffleGenerator);
 }
 
+std::uint32_t Dataset::trainingBatchCount(const std::uint32_t batchSize) const
+{
+    return mEpochSize() == 0 ? 0 : (mEpochSize() - 1) / batchSize;
+}
 
-
-void Dataset::loadTrainingBatch(const std::uint32_t &batchSize)
+void Dataset::gatherTrainingBatch(const std::uint32_t first, const std::uint32_t batchSize, std::shared_ptr<Tensor> &data, std::shared_ptr<Tensor> &labels) const
 {
-    if (mIndex + batchSize > mTrainingIndices.size())
+    if (first + batchSize > mEpochSize())
     {
         throw std::invalid_argument("The batch size is larger than the remaining size of the training set.");
     }
-    dataType dataBatch;
-    dataType labelBatch;
-
-    while (dataBatch.size() < batchSize)
+    if (mpStream != nullptr)
     {
-        if (mTrainingIndices[mIndex] < mTrainingData.size())
+        if (first != mpStream->position())
         {
-            dataBatch.push_back(mTrainingData[mTrainingIndices[mIndex]]);
-            labelBatch.push_back(mTrainingLabels[mTrainingIndices[mIndex]]);
+            throw std::invalid_argument("Dataset::gatherTrainingBatch: A streamed training set can only be read in order.");
         }
-        else
+        mpStream->next(batchSize, data, labels);
+        return;
+    }
+    auto gather = [&](std::shared_ptr<Tensor> &batch, const SampleStorage &training, const SampleStorage &validation) {
+        const std::vector<size_t> shape = {batchSize, training.width()};
+        if (batch == nullptr || batch.use_count() > 1 || batch->shape() != shape) // tensors nobody else holds are overwritten
         {
-            dataBatch.push_back(mValidationData[mTrainingIndices[mIndex] - mTrainingData.size()]);
-            labelBatch.push_back(mValidationLabels[mTrainingIndices[mIndex] - mTrainingData.size()]);
+            batch = std::make_shared<Tensor>(Tensor(shape, 0));
         }
-        mIndex++;
+        Precision *pBatch = batch->data();
+        for (std::uint32_t i = first; i < first + batchSize; i++, pBatch += shape[1])
+        {
+            const std::uint32_t index = mTrainingIndices[i];
+            if (index < training.size())
+            {
+                training.copyRow(index, pBatch);
+            }
+            else
+            {
+                validation.copyRow(index - training.size(), pBatch);
+            }
+        }
+    };
+    gather(data, mTrainingData, mValidationData);
+    gather(labels, mTrainingLabels, mValidationLabels);
+}
+
+void Dataset::loadTrainingBatch(const std::uint32_t &batchSize)
+{
+    if (mIndex + batchSize > mEpochSize()) // before the prefetcher, which would wait for a batch past the end of the epoch
+    {
+        throw std::invalid_argument("The batch size is larger than the remaining size of the training set.");
     }
+    std::shared_ptr<Tensor> data;
+    std::shared_ptr<Tensor> labels;
+    if (mpPrefetcher != nullptr)
+    {
+        if (!mpPrefetcher->ready(mIndex, batchSize))
+        {
+            mpPrefetcher->start([this, batchSize](const std::uint32_t first, std::shared_ptr<Tensor> &pData, std::shared_ptr<Tensor> &pLabels) {
+                gatherTrainingBatch(first, batchSize, pData, pLabels); }, mIndex, batchSize, mEpochSize());
+        }
+        mpPrefetcher->take(data, labels);
+    }
+    else
+    {
+        gatherTrainingBatch(mIndex, batchSize, data, labels);
+    }
+    mIndex += batchSize;
+
+    mDataVariable->setData(data);
+    mLabelVariable->setData(labels);
+}
 
-    mDataVariable->setData(std::make_shared<Tensor>(Matrix(dataBatch)));
-    mLabelVariable->setData(std::make_shared<Tensor>(Matrix(labelBatch)));
+void Dataset::setPrefetching(const std::uint32_t depth)
+{
+    mpPrefetcher = depth > 0 ? std::make_shared<BatchPrefetcher>(depth) : nullptr;
+}
+
+void Dataset::setScaling(const Precision scale, const Precision offset)
+{
+    setScaling(std::vector<Precision>{scale}, std::vector<Precision>{offset});
+}
+
+void Dataset::setScaling(const std::vector<Precision> &scale, const std::vector<Precision> &offset)
+{
+    if (mpPrefetcher != nullptr)
+    {
+        mpPrefetcher->stop(); // it reads the scaling
+    }
+    for (SampleStorage *pStorage : {&mTrainingData, &mValidationData, &mTestData})
+    {
+        pStorage->setTransformation(scale, offset);
+    }
+    if (mpStream != nullptr)
+    {
+        mpStream->setTransformation(scale, offset);
+    }
+}
+
+Preprocessing::Statistics Dataset::mTrainingStatistics() const
+{
+    Preprocessing::Statistics statistics = Preprocessing::statistics(mTrainingData);
+    statistics.merge(Preprocessing::statistics(mValidationData)); // the validation set is part of the training set of shuffleTrainingSet(true)
+    return statistics;
+}
+
+void Dataset::normalize()
+{
+    if (mpStream != nullptr)
+    {
+        throw std::invalid_argument("Dataset::normalize: The maximum of a streamed training set is unknown, use setScaling.");
+    }
+    const Precision maximum = static_cast<Precision>(mTrainingStatistics().largest());
+    if (!(maximum > 0))
+    {
+        throw std::invalid_argument("Dataset::normalize: The largest value of the training set must be positive.");
+    }
+    setScaling(1 / maximum);
+}
+
+void Dataset::standardize()
+{
+    if (mpStream != nullptr)
+    {
+        throw std::invalid_argument("Dataset::standardize: The statistics of a streamed training set are unknown, use setScaling.");
+    }
+    const Preprocessing::Statistics statistics = mTrainingStatistics();
+    if (statistics.count == 0)
+    {
+        throw std::invalid_argument("Dataset::standardize: The training set is empty.");
+    }
+    const std::vector<double> deviation = statistics.standardDeviation();
+    std::vector<Precision> scale(deviation.size());
+    std::vector<Precision> offset(deviation.size());
+    for (size_t j = 0; j < deviation.size(); j++)
+    {
+        scale[j] = static_cast<Precision>(deviation[j] > 0 ? 1 / deviation[j] : 1);
+        offset[j] = static_cast<Precision>(-statistics.mean[j] * scale[j]);
+    }
+    setScaling(scale, offset);
 }
 
 void Dataset::loadValidationSet() const
 {
-    mDataVariable->setData(std::make_shared<Tensor>(Matrix(mValidationData)));
-    mLabelVariable->setData(std::make_shared<Tensor>(Matrix(mValidationLabels)));
+    mDataVariable->setData(mValidationData.tensor());
+    mLabelVariable->setData(mValidationLabels.tensor());
 }
 
 void Dataset::loadTestSet() const
 {
-    mDataVariable->setData(std::make_shared<Tensor>(Matrix(mTestData)));
-    mLabelVariable->setData(std::make_shared<Tensor>(Matrix(mTestLabels)));
+    mDataVariable->setData(mTestData.tensor());
+    mLabelVariable->setData(mTestLabels.tensor());
 }
 
 std::vector<std::shared_ptr<Variable>> Dataset::getInputs()
@@ -5,16 +5,16 @@
 
 std::shared_ptr<ParameterNormPenaltyVariant> Dense::mpsDefaultNorm = nullptr;
 
-Dense::Dense(const ActivationVariant &activationFunction, const std::uint32_t units, const std::string& name, const double& dropout) :
+Dense::Dense(const ActivationVariant &activationFunction, const std::uint32_t units, const std::string& name, const double& dropout, const std::uint32_t shards) :
 Dense(std::visit([]<typename T0>(T0&& arg) {
     // Assuming all types in the variant can be dynamically cast to Operation*
-    return std::shared_ptr<Operation>(std::make_shared<std::decay_t<T0>>(arg));}, activationFunction), units, name, dropout)
+    return std::shared_ptr<Operation>(std::make_shared<std::decay_t<T0>>(arg));}, activationFunction), units, name, dropout, shards)
 {
 
 }
 
 
-Dense::Dense(const std::shared_ptr<Operation> &activationFunction, const std::uint32_t size, const std::string& name, const double& dropout) : Layer(name)
+Dense::Dense(const std::shared_ptr<Operation> &activationFunction, const std::uint32_t size, const std::string& name, const double& dropout, const std::uint32_t shards) : Layer(name)
 {
     mSize = size; // set the number of neurons in the layer
 
@@ -22,15 +22,38 @@ Dense::Dense(const std::shared_ptr<Operation> &activationFunction, const std::ui
     mpDropoutVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(std::make_shared<Dropout>(Dropout(dropout)))));
     mpPaddingVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(std::make_shared<Padding>(Padding(0,1,1)), {mpDropoutVariable}))); // pad for weights
 
-    mpWeightMatrixVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(std::make_shared<WeightMatrixInitializer>(WeightMatrixInitializer(size, std::make_shared<NormalizedInitialization>(), std::dynamic_pointer_cast<ReLU>(activationFunction) ? 0.1 : 0)), {mpPaddingVariable})));
-    mpMatmulVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(std::make_shared<Matmul>(Matmul()), {mpPaddingVariable,mpWeightMatrixVariable})));
+    const double bias = std::dynamic_pointer_cast<ReLU>(activationFunction) ? 0.1 : 0;
+    if (shards > 1) // tensor parallel: the weights are split by output columns
+    {
+        if (shards > size)
+        {
+            throw std::invalid_argument("Dense::Dense: A layer can not have more shards than units.");
+        }
+        std::vector<std::shared_ptr<Variable>> matmulInputs = {mpPaddingVariable};
+        for (std::uint32_t s = 0; s < shards; s++)
+        {
+            const std::uint32_t units = size / shards + (s < size % shards ? 1 : 0);
+            mWeightShardVariables.push_back(GRAPH->addVariable(std::make_shared<Variable>(Variable(std::make_shared<WeightMatrixInitializer>(WeightMatrixInitializer(units, std::make_shared<NormalizedInitialization>(), bias, size)), {mpPaddingVariable}))));
+            matmulInputs.push_back(mWeightShardVariables.back());
+        }
+        mpMatmulVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(std::make_shared<ShardedMatmul>(shards), matmulInputs)));
+    }
+    else
+    {
+        mpWeightMatrixVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(std::make_shared<WeightMatrixInitializer>(WeightMatrixInitializer(size, std::make_shared<NormalizedInitialization>(), bias)), {mpPaddingVariable})));
+        mpMatmulVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(std::make_shared<Matmul>(Matmul()), {mpPaddingVariable,mpWeightMatrixVariable})));
+        mWeightShardVariables = {mpWeightMatrixVariable};
+    }
     mpActivationVariable = GRAPH->addVariable(std::make_shared<Variable>(Variable(activationFunction, {mpMatmulVariable})));
 
     // connections within the module
     mpDropoutVariable->getConsumers().push_back(mpPaddingVariable);
     mpPaddingVariable->getConsumers().push_back(mpMatmulVariable);
-    mpPaddingVariable->getConsumers().push_back(mpWeightMatrixVariable);
-    mpWeightMatrixVariable->getConsumers().push_back(mpMatmulVariable);
+    for (const std::shared_ptr<Variable> &pWeights : mWeightShardVariables)
+    {
+        mpPaddingVariable->getConsumers().push_back(pWeights);
+        pWeights->getConsumers().push_back(mpMatmulVariable);
+    }
     mpMatmulVariable->getConsumers().push_back(mpActivationVariable);
 
     // Initialize default norm if not already set
@@ -71,7 +94,7 @@ std::vector<std::shared_ptr<Variable>> Dense::getLearnableVariables()
     {
         return {mpWeightMatrixVariable, mpNormVariable};
     }
-    return {mpWeightMatrixVariable};
+    return mWeightShardVariables;
 }
 
 std::vector<std::shared_ptr<Variable>> Dense::getGradientVariables()
@@ -83,6 +106,59 @@ std::vector<std::shared_ptr<Variable>> Dense::getGradientVariables()
     return {};
 }
 
+std::uint64_t Dense::quantize()
+{
+    const std::shared_ptr<Tensor> &input = mpPaddingVariable->getData();
+    if (mpWeightMatrixVariable == nullptr)
+    {
+        throw std::invalid_argument("Dense::quantize: Tensor parallel layers can not be quantized.");
+    }
+    if (input == nullptr || mpWeightMatrixVariable->getOperation() != nullptr)
+    {
+        throw std::invalid_argument("Dense::quantize: Run a calibration batch through the layer first.");
+    }
+
+    // the range of the inputs without the padding column
+    const std::uint64_t columns = input->shape(1) - 1;
+    const Precision *pInput = input->data();
+    Precision minimum = 0;
+    Precision maximum = 0;
+    for (std::uint64_t i = 0; i < input->shape(0); i++)
+    {
+        for (std::uint64_t j = 0; j < columns; j++)
+        {
+            minimum = std::min(minimum, pInput[i * input->shape(1) + j]);
+            maximum = std::max(maximum, pInput[i * input->shape(1) + j]);
+        }
+    }
+
+    const std::shared_ptr<QuantizedMatmul> pQuantized = std::make_shared<QuantizedMatmul>(*mpWeightMatrixVariable->getData(), minimum, maximum);
+    pQuantized->setVariable(mpMatmulVariable);
+    mpMatmulVariable->setOperation(pQuantized);
+    return pQuantized->bytes();
+}
+
+void Dense::dequantize()
+{
+    if (mpWeightMatrixVariable == nullptr)
+    {
+        return;
+    }
+    const std::shared_ptr<Matmul> pMatmul = std::make_shared<Matmul>();
+    pMatmul->setVariable(mpMatmulVariable);
+    mpMatmulVariable->setOperation(pMatmul);
+}
+
+std::uint64_t Dense::weightBytes() const
+{
+    std::uint64_t bytes = 0;
+    for (const std::shared_ptr<Variable> &pWeights : mWeightShardVariables)
+    {
+        bytes += pWeights->getData() == nullptr ? 0 : pWeights->getData()->capacity() * sizeof(Precision);
+    }
+    return bytes;
+}
+
 void Dense::setDefaultNorm(ParameterNormPenaltyVariant const & norm)
 {
     mpsDefaultNorm = std::make_shared<ParameterNormPenaltyVariant>(norm);
@@ -3,12 +3,12 @@
 //
 #include "operation/activation_function/heavyside_step.hpp"
 
-double HeavysideStep::activationFunction(double input)
+Precision HeavysideStep::activationFunction(Precision input)
 {
     return input >= 0 ? 1 : 0;
 }
 
-double HeavysideStep::activationFunctionDerivative(double input)
+Precision HeavysideStep::activationFunctionDerivative(Precision input)
 {
     return 0;
 }
\ No newline at end of file
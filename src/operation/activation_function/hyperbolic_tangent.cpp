@@ -3,12 +3,12 @@
 //
 #include "operation/activation_function/hyperbolic_tangent.hpp"
 
-double HyperbolicTangent::activationFunction(double input)
+Precision HyperbolicTangent::activationFunction(Precision input)
 {
     return tanh(input);
 }
 
-double HyperbolicTangent::activationFunctionDerivative(double input)
+Precision HyperbolicTangent::activationFunctionDerivative(Precision input)
 {
     return 1 - pow(activationFunction(input), 2);
 }
\ No newline at end of file
@@ -3,12 +3,12 @@
 //
 #include "operation/activation_function/linear.hpp"
 
-double Linear::activationFunction(double input)
+Precision Linear::activationFunction(Precision input)
 {
     return input;
 }
 
-double Linear::activationFunctionDerivative(double input)
+Precision Linear::activationFunctionDerivative(Precision input)
 {
     return 1;
 }
\ No newline at end of file
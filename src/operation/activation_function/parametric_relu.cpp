@@ -16,12 +16,12 @@ void ParametricReLU::f(std::vector<std::shared_ptr<Variable>>& inputs)
     }
 
     // calculate the PReLU activation function
-    double slope = inputs[0]->getData()->at(0);
+    Precision slope = inputs[0]->getData()->at(0);
     std::shared_ptr<Tensor> result = std::make_shared<Tensor>(inputs[1]->getData()->shape());
 
     for(std::uint32_t i = 0; i < inputs[1]->getData()->capacity(); i++)
     {
-        double input = inputs[1]->getData()->at(i);
+        Precision input = inputs[1]->getData()->at(i);
         result->set(i, input >= 0 ? input : slope * input);
     }
 
@@ -47,7 +47,7 @@ std::shared_ptr<Tensor> ParametricReLU::bprop(std::vector<std::shared_ptr<Variab
         double sum = 0;
         for(std::uint32_t i = 0; i < gradient->capacity(); i++)
         {
-            double input = inputs[1]->getData()->at(i);
+            Precision input = inputs[1]->getData()->at(i);
             sum += input < 0 ? input * gradient->at(i) : 0;
         }
         // store the result
@@ -56,12 +56,12 @@ std::shared_ptr<Tensor> ParametricReLU::bprop(std::vector<std::shared_ptr<Variab
     if(focus == inputs[1])
     {
         // calculate the gradient of the input
-        double slope = inputs[0]->getData()->at(0);
+        Precision slope = inputs[0]->getData()->at(0);
         std::shared_ptr<Tensor> result = std::make_shared<Tensor>(inputs[1]->getData()->shape());
 
         for(std::uint32_t i = 0; i < gradient->capacity(); i++)
         {
-            double input = inputs[1]->getData()->at(i);
+            Precision input = inputs[1]->getData()->at(i);
             result->set(i, input >= 0 ? gradient->at(i) : slope * gradient->at(i));
         }
         // store the result
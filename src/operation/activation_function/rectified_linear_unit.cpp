@@ -6,18 +6,18 @@
 /**
  * @brief Constructor for the ReLU class.
 */
-ReLU::ReLU(double gradient)
+ReLU::ReLU(Precision gradient)
 {
     __gradient = gradient; // gradient of (-inf, 0)
     mName = "RELU";
 }
 
-double ReLU::activationFunction(double input)
+Precision ReLU::activationFunction(Precision input)
 {
     return input >= 0 ? input : __gradient * input;
 }
 
-double ReLU::activationFunctionDerivative(double input)
+Precision ReLU::activationFunctionDerivative(Precision input)
 {
     return input >= 0 ? 1 : __gradient;
 }
\ No newline at end of file
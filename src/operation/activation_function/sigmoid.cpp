@@ -3,12 +3,12 @@
 //
 #include "operation/activation_function/sigmoid.hpp"
 
-double Sigmoid::activationFunction(double input)
+Precision Sigmoid::activationFunction(Precision input)
 {
     return 1 / (1 + exp(-input));
 }
 
-double Sigmoid::activationFunctionDerivative(double input)
+Precision Sigmoid::activationFunctionDerivative(Precision input)
 {
     return activationFunction(input) * (1 - activationFunction(input));
 }
\ No newline at end of file
@@ -11,42 +11,26 @@ void Softmax::f(std::vector<std::shared_ptr<Variable>>& inputs)
         throw std::invalid_argument("Softmax::f: Invalid number of input variables.");
     }
 
-    std::shared_ptr<Tensor> _data = std::make_shared<Tensor>(inputs.front()->getData()->shape()); // create a new tensor to store the result
+    Tensor &input = *inputs.front()->getData();
+    std::shared_ptr<Tensor> _data = std::make_shared<Tensor>(input.shape()); // create a new tensor to store the result
 
-    for (std::uint32_t i = 0; i < inputs.front()->getData()->shape()[0]; i++)
-    {
-
-        double _max = inputs.front()->getData()->at({i, 0}); // normalize the input to avoid overflow / underflow
-        for (std::uint32_t j = 0; j < inputs.front()->getData()->shape()[1]; j++)
-        {
-            if (inputs.front()->getData()->at({i, j}) > _max)
-            {
-                _max = inputs.front()->getData()->at({i, j});
-            }
-        }
-
-
-        double _sum = 0;
-        for (std::uint32_t j = 0; j < inputs.front()->getData()->shape()[1]; j++)
-        {
-            _sum += std::exp(inputs.front()->getData()->at({i, j}) - _max);
-        }
+    const size_t rows = input.shape(0);
+    const size_t cols = input.shape(1);
+    const Tensor logSum = Reduction::logSumExp(input, {1}, true); // log(sum(exp(x))) of every row, shifted by the row maximum to avoid overflow / underflow
 
-        if (mUseWithExp)
-        {
-            for (std::uint32_t j = 0; j < inputs.front()->getData()->shape()[1]; j++)
-            {
-                _data->set({i, j}, std::exp(inputs.front()->getData()->at({i, j}) - _max) / _sum);
-            }
-        }
-        else
+    const Precision *pInput = input.data();
+    const Precision *pLogSum = logSum.data();
+    Precision *pData = _data->data();
+    Parallel::forRange(rows, rows * cols, [&](const std::uint64_t begin, const std::uint64_t end) {
+        for (std::uint64_t i = begin; i < end; i++)
         {
-            for (std::uint32_t j = 0; j < inputs.front()->getData()->shape()[1]; j++)
+            for (std::uint64_t j = 0; j < cols; j++)
             {
-                _data->set({i, j}, inputs[0]->getData()->at({i, j}) - _max - std::log(_sum));
+                const Precision logProbability = pInput[i * cols + j] - pLogSum[i];
+                pData[i * cols + j] = mUseWithExp ? std::exp(logProbability) : logProbability;
             }
         }
-    }
+    });
     this->getVariable()->getData() = _data; // store the result in the variable
 }
 
@@ -0,0 +1,95 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+#include "operation/batched_matmul.hpp"
+
+namespace
+{
+    /**
+     * @brief the batch size and matrix sizes of a batched product, checks that the shapes fit together
+     */
+    void dimensions(Tensor &left, Tensor &right, std::uint64_t &batch, std::uint64_t &m, std::uint64_t &n, std::uint64_t &k)
+    {
+        const std::uint32_t leftDims = left.dimensionality();
+        const std::uint32_t rightDims = right.dimensionality();
+        if (leftDims < 2 || leftDims > 3 || rightDims < 2 || rightDims > 3 || (leftDims == 2 && rightDims == 2))
+        {
+            throw std::invalid_argument("BatchedMatmul: The inputs must be a batch of matrices and a batch of matrices or a single matrix.");
+        }
+        if (leftDims == 3 && rightDims == 3 && left.shape(0) != right.shape(0))
+        {
+            throw std::invalid_argument("BatchedMatmul: The batch sizes of the inputs do not match.");
+        }
+        batch = leftDims == 3 ? left.shape(0) : right.shape(0);
+        m = left.shape(leftDims - 2);
+        k = left.shape(leftDims - 1);
+        n = right.shape(rightDims - 1);
+        if (right.shape(rightDims - 2) != k)
+        {
+            throw std::invalid_argument("BatchedMatmul: Invalid shapes of the input matrices.");
+        }
+    }
+}
+
+void BatchedMatmul::f(std::vector<std::shared_ptr<Variable>>& inputs)
+{
+    if (inputs.size() != 2)
+    {
+        throw std::invalid_argument("BatchedMatmul::f: Invalid number of input variables.");
+    }
+
+    Tensor &left = *inputs[0]->getData();
+    Tensor &right = *inputs[1]->getData();
+    std::uint64_t batch, m, n, k;
+    dimensions(left, right, batch, m, n, k);
+
+    std::shared_ptr<Tensor> result = std::make_shared<Tensor>(std::vector<size_t>{batch, m, n});
+    const std::uint64_t strideLeft = left.dimensionality() == 3 ? m * k : 0; // a shared matrix is used by every product
+    const std::uint64_t strideRight = right.dimensionality() == 3 ? k * n : 0;
+    Gemm::stridedBatched({left.data(), right.data(), result->data(), m, n, k}, batch, strideLeft, strideRight, m * n);
+    this->getVariable()->getData() = result;
+}
+
+std::shared_ptr<Tensor> BatchedMatmul::bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient)
+{
+    if (inputs.size() != 2)
+    {
+        throw std::invalid_argument("BatchedMatmul::bprop: Invalid number of input variables.");
+    }
+
+    Tensor &left = *inputs[0]->getData();
+    Tensor &right = *inputs[1]->getData();
+    std::uint64_t batch, m, n, k;
+    dimensions(left, right, batch, m, n, k);
+    const bool sharedLeft = left.dimensionality() == 2;
+    const bool sharedRight = right.dimensionality() == 2;
+
+    if (inputs[0]->getId() == focus->getId())
+    {
+        // dA[b] = G[b] * B[b]^T, a shared A gets the sum over the batch
+        std::shared_ptr<Tensor> result = std::make_shared<Tensor>(std::vector<size_t>{batch, m, k});
+        Gemm::Problem problem = {gradient->data(), right.data(), result->data(), m, k, n};
+        problem.transposeB = true;
+        Gemm::stridedBatched(problem, batch, m * n, sharedRight ? 0 : k * n, m * k);
+        if (sharedLeft)
+        {
+            return std::make_shared<Tensor>(Reduction::sum(*result, {0}));
+        }
+        return result;
+    }
+
+    // dB[b] = A[b]^T * G[b]
+    if (sharedRight) // the sum over the batch is one product of the stacked matrices: [batch * m, k]^T x [batch * m, n]
+    {
+        std::shared_ptr<Tensor> result = std::make_shared<Tensor>(std::vector<size_t>{k, n});
+        Gemm::Problem problem = {left.data(), gradient->data(), result->data(), k, n, batch * m};
+        problem.transposeA = true;
+        Gemm::multiply(problem);
+        return result;
+    }
+    std::shared_ptr<Tensor> result = std::make_shared<Tensor>(std::vector<size_t>{batch, k, n});
+    Gemm::Problem problem = {left.data(), gradient->data(), result->data(), k, n, m};
+    problem.transposeA = true;
+    Gemm::stridedBatched(problem, batch, sharedLeft ? 0 : m * k, m * n, k * n);
+    return result;
+}
@@ -0,0 +1,388 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+#include "operation/einsum.hpp"
+
+Einsum::Einsum(const std::string &specification)
+{
+    parse(specification, mInputLabels, mOutputLabels);
+    mName = "EINSUM";
+}
+
+void Einsum::parse(const std::string &specification, std::vector<Labels> &inputs, Labels &output)
+{
+    std::string compact;
+    std::ranges::copy_if(specification, std::back_inserter(compact), [](const char c) { return c != ' '; });
+
+    const size_t arrow = compact.find("->");
+    const std::string left = compact.substr(0, arrow);
+    inputs.clear();
+    size_t begin = 0;
+    while (true)
+    {
+        const size_t comma = left.find(',', begin);
+        inputs.push_back(left.substr(begin, comma - begin));
+        if (comma == std::string::npos)
+        {
+            break;
+        }
+        begin = comma + 1;
+    }
+
+    std::map<char, std::uint32_t> count;
+    for (const Labels &labels : inputs)
+    {
+        for (const char c : labels)
+        {
+            if (!std::isalpha(static_cast<unsigned char>(c)))
+            {
+                throw std::invalid_argument("Einsum::parse: Indices must be letters.");
+            }
+            if (std::ranges::count(labels, c) > 1)
+            {
+                throw std::invalid_argument("Einsum::parse: Repeated indices within an operand (traces, diagonals) are not supported.");
+            }
+            count[c]++;
+        }
+    }
+
+    if (arrow == std::string::npos) // implicit output: the indices that appear once, in alphabetical order
+    {
+        output.clear();
+        for (const auto &[c, n] : count)
+        {
+            if (n == 1)
+            {
+                output.push_back(c);
+            }
+        }
+        return;
+    }
+    output = compact.substr(arrow + 2);
+    for (const char c : output)
+    {
+        if (!count.contains(c))
+        {
+            throw std::invalid_argument("Einsum::parse: Every output index must appear in an input.");
+        }
+        if (std::ranges::count(output, c) > 1)
+        {
+            throw std::invalid_argument("Einsum::parse: Repeated indices in the output are not supported.");
+        }
+    }
+}
+
+std::shared_ptr<Tensor> Einsum::sumOut(const std::shared_ptr<Tensor> &tensor, Labels &labels, const Labels &keep)
+{
+    ShapeVector axes;
+    Labels remaining;
+    for (size_t i = 0; i < labels.size(); i++)
+    {
+        if (keep.find(labels[i]) == std::string::npos)
+        {
+            axes.push_back(i);
+        }
+        else
+        {
+            remaining.push_back(labels[i]);
+        }
+    }
+    if (axes.empty())
+    {
+        return tensor;
+    }
+    labels = remaining;
+    return std::make_shared<Tensor>(Reduction::sum(*tensor, axes));
+}
+
+std::shared_ptr<Tensor> Einsum::arrange(const std::shared_ptr<Tensor> &tensor, const Labels &labels, const Labels &order)
+{
+    if (labels == order)
+    {
+        return tensor;
+    }
+    ShapeVector axes(order.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        axes[i] = labels.find(order[i]);
+    }
+    return std::make_shared<Tensor>(tensor->permute(axes));
+}
+
+std::shared_ptr<Tensor> Einsum::broadcast(const std::shared_ptr<Tensor> &tensor, const Labels &labels, const Labels &full, const std::map<char, size_t> &sizes)
+{
+    if (labels == full)
+    {
+        return tensor;
+    }
+
+    // the strides of the source along the indices of the result, 0 for the repeated indices
+    const size_t n = full.size();
+    ShapeVector shape(n);
+    ShapeVector strides(n, 0);
+    for (size_t i = 0; i < n; i++)
+    {
+        shape[i] = sizes.at(full[i]);
+    }
+    size_t stride = 1;
+    for (size_t i = labels.size(); i > 0; i--)
+    {
+        strides[full.find(labels[i - 1])] = stride;
+        stride *= sizes.at(labels[i - 1]);
+    }
+
+    std::shared_ptr<Tensor> result = std::make_shared<Tensor>(shape);
+    const Precision *pSource = tensor->data();
+    Precision *pResult = result->data();
+    ShapeVector index(n, 0);
+    size_t offset = 0;
+    for (size_t i = 0; i < result->capacity(); i++)
+    {
+        pResult[i] = pSource[offset];
+        for (size_t axis = n; axis > 0; axis--) // increment the multi-index and the source offset
+        {
+            index[axis - 1]++;
+            offset += strides[axis - 1];
+            if (index[axis - 1] < shape[axis - 1])
+            {
+                break;
+            }
+            offset -= index[axis - 1] * strides[axis - 1];
+            index[axis - 1] = 0;
+        }
+    }
+    return result;
+}
+
+std::shared_ptr<Tensor> Einsum::contractPair(std::shared_ptr<Tensor> left, Labels leftLabels, std::shared_ptr<Tensor> right, Labels rightLabels, const Labels &needed, const std::map<char, size_t> &sizes, Labels &labels)
+{
+    // indices only one side has and nobody needs can be summed over right away
+    left = sumOut(left, leftLabels, needed + rightLabels);
+    right = sumOut(right, rightLabels, needed + leftLabels);
+
+    Labels batch, rows, columns, contracted;
+    for (const char c : leftLabels)
+    {
+        const bool shared = rightLabels.find(c) != std::string::npos;
+        const bool kept = needed.find(c) != std::string::npos;
+        if (shared && kept)
+        {
+            batch.push_back(c);
+        }
+        else if (shared)
+        {
+            contracted.push_back(c);
+        }
+        else
+        {
+            rows.push_back(c);
+        }
+    }
+    for (const char c : rightLabels)
+    {
+        if (leftLabels.find(c) == std::string::npos)
+        {
+            columns.push_back(c);
+        }
+    }
+
+    auto product = [&](const Labels &group) {
+        size_t result = 1;
+        for (const char c : group)
+        {
+            result *= sizes.at(c);
+        }
+        return result;
+    };
+
+    // lower to a batched matrix product: [batch, rows, contracted] x [batch, contracted, columns]
+    left = arrange(left, leftLabels, batch + rows + contracted);
+    right = arrange(right, rightLabels, batch + contracted + columns);
+    labels = batch + rows + columns;
+    ShapeVector shape;
+    for (const char c : labels)
+    {
+        shape.push_back(sizes.at(c));
+    }
+    if (shape.empty())
+    {
+        shape.push_back(1);
+    }
+    std::shared_ptr<Tensor> result = std::make_shared<Tensor>(shape);
+    const std::uint64_t m = product(rows), n = product(columns), k = product(contracted);
+    Gemm::stridedBatched({left->data(), right->data(), result->data(), m, n, k}, product(batch), m * k, k * n, m * n);
+    return result;
+}
+
+std::shared_ptr<Tensor> Einsum::contract(std::vector<std::shared_ptr<Tensor>> operands, std::vector<Labels> labels, const Labels &output)
+{
+    if (operands.size() != labels.size() || operands.empty())
+    {
+        throw std::invalid_argument("Einsum::contract: Every operand needs its indices.");
+    }
+
+    std::map<char, size_t> sizes;
+    for (size_t i = 0; i < operands.size(); i++)
+    {
+        if (labels[i].empty() ? operands[i]->capacity() != 1 : operands[i]->dimensionality() != labels[i].size())
+        {
+            throw std::invalid_argument("Einsum::contract: The number of indices does not match the dimensionality of an operand.");
+        }
+        for (size_t axis = 0; axis < labels[i].size(); axis++)
+        {
+            const auto [iterator, inserted] = sizes.emplace(labels[i][axis], operands[i]->shape(axis));
+            if (!inserted && iterator->second != operands[i]->shape(axis))
+            {
+                throw std::invalid_argument("Einsum::contract: An index has different sizes in different operands.");
+            }
+        }
+    }
+
+    // greedy order: always contract the pair with the fewest multiply-adds, ties go to the smaller result
+    while (operands.size() > 1)
+    {
+        size_t bestLeft = 0, bestRight = 1;
+        std::pair<size_t, size_t> bestCost = {std::numeric_limits<size_t>::max(), std::numeric_limits<size_t>::max()};
+        for (size_t i = 0; i < operands.size(); i++)
+        {
+            for (size_t j = i + 1; j < operands.size(); j++)
+            {
+                Labels needed = output;
+                for (size_t other = 0; other < operands.size(); other++)
+                {
+                    if (other != i && other != j)
+                    {
+                        needed += labels[other];
+                    }
+                }
+                size_t work = 1, size = 1;
+                std::set<char> all(labels[i].begin(), labels[i].end());
+                all.insert(labels[j].begin(), labels[j].end());
+                for (const char c : all)
+                {
+                    work *= sizes.at(c);
+                    size *= needed.find(c) != std::string::npos ? sizes.at(c) : 1;
+                }
+                if (std::pair(work, size) < bestCost)
+                {
+                    bestCost = {work, size};
+                    bestLeft = i;
+                    bestRight = j;
+                }
+            }
+        }
+
+        Labels needed = output;
+        for (size_t other = 0; other < operands.size(); other++)
+        {
+            if (other != bestLeft && other != bestRight)
+            {
+                needed += labels[other];
+            }
+        }
+        Labels resultLabels;
+        std::shared_ptr<Tensor> result = contractPair(operands[bestLeft], labels[bestLeft], operands[bestRight], labels[bestRight], needed, sizes, resultLabels);
+        operands.erase(operands.begin() + bestRight); // bestRight > bestLeft, so bestLeft stays valid
+        labels.erase(labels.begin() + bestRight);
+        operands[bestLeft] = result;
+        labels[bestLeft] = resultLabels;
+    }
+
+    std::shared_ptr<Tensor> result = sumOut(operands.front(), labels.front(), output);
+    if (output.empty())
+    {
+        result = std::make_shared<Tensor>(*result);
+        result->reshape({1});
+        return result;
+    }
+    return arrange(result, labels.front(), output);
+}
+
+void Einsum::f(std::vector<std::shared_ptr<Variable>>& inputs)
+{
+    if (inputs.size() != mInputLabels.size())
+    {
+        throw std::invalid_argument("Einsum::f: Invalid number of input variables.");
+    }
+
+    std::vector<std::shared_ptr<Tensor>> operands;
+    for (const std::shared_ptr<Variable> &input : inputs)
+    {
+        operands.push_back(input->getData());
+    }
+    std::shared_ptr<Tensor> result = contract(operands, mInputLabels, mOutputLabels);
+    if (std::ranges::find(operands, result) != operands.end()) // never alias the data of an input
+    {
+        result = std::make_shared<Tensor>(*result);
+    }
+    this->getVariable()->getData() = result;
+}
+
+std::shared_ptr<Tensor> Einsum::bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient)
+{
+    if (inputs.size() != mInputLabels.size())
+    {
+        throw std::invalid_argument("Einsum::bprop: Invalid number of input variables.");
+    }
+
+    std::map<char, size_t> sizes;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        for (size_t axis = 0; axis < mInputLabels[i].size(); axis++)
+        {
+            sizes[mInputLabels[i][axis]] = inputs[i]->getData()->shape(axis);
+        }
+    }
+
+    // an input can appear several times, its gradient is the sum over all appearances
+    std::shared_ptr<Tensor> result = nullptr;
+    for (size_t focusIndex = 0; focusIndex < inputs.size(); focusIndex++)
+    {
+        if (inputs[focusIndex]->getId() != focus->getId())
+        {
+            continue;
+        }
+
+        std::vector<std::shared_ptr<Tensor>> operands = {gradient};
+        std::vector<Labels> labels = {mOutputLabels};
+        Labels available = mOutputLabels;
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            if (i != focusIndex)
+            {
+                operands.push_back(inputs[i]->getData());
+                labels.push_back(mInputLabels[i]);
+                available += mInputLabels[i];
+            }
+        }
+
+        // the indices that were summed over without touching another operand get the gradient repeated
+        Labels present;
+        for (const char c : mInputLabels[focusIndex])
+        {
+            if (available.find(c) != std::string::npos)
+            {
+                present.push_back(c);
+            }
+        }
+        std::shared_ptr<Tensor> part = broadcast(contract(operands, labels, present), present, mInputLabels[focusIndex], sizes);
+
+        if (result == nullptr)
+        {
+            result = part == gradient ? std::make_shared<Tensor>(*part) : part;
+            continue;
+        }
+        Precision *pResult = result->data();
+        const Precision *pPart = part->data();
+        for (size_t i = 0; i < result->capacity(); i++)
+        {
+            pResult[i] += pPart[i];
+        }
+    }
+
+    if (result == nullptr)
+    {
+        throw std::invalid_argument("Einsum::bprop: The focus variable is not an input variable.");
+    }
+    return result;
+}
@@ -3,103 +3,28 @@
 //
 #include "operation/matmul.hpp"
 
-void Matmul::blockmul(Matrix &left_matrix, Matrix &right_matrix, Matrix &result, const std::uint32_t &k, const bool &left_transpose, const bool &right_transpose)
-{
-    std::vector<float> &left_data = left_matrix.getData();
-    std::vector<float> &right_data = right_matrix.getData();
-    std::vector<size_t> &left_shape = left_matrix.getShape();
-    std::vector<size_t> &right_shape = right_matrix.getShape();
-    std::uint32_t left_index = 0;
-    std::uint32_t right_index = 0;
-    if (!left_transpose && !right_transpose)
-    {
-        for (std::uint32_t i = 0; i < left_matrix.shape(0); ++i)
-        {
-            left_index = i * left_shape[1];
-            right_index = k;
-            Precision sum = 0;
-            const std::uint32_t shape = left_matrix.shape(1);
-            const std::uint32_t right_stride = right_shape[1];
-            for (std::uint32_t j = 0; j < shape; ++j)
-            {
-                sum += left_data[left_index] * right_data[right_index];
-                left_index++;
-                right_index += right_stride;
-            }
-            result.set(i, k, sum);
-        }
-    }
-    else if (left_transpose && !right_transpose)
-    {
-        for (std::uint32_t i = 0; i < left_matrix.shape(1); ++i)
-        {
-            left_index = i;
-            right_index = k;
-            Precision sum = 0;
-            const std::uint32_t shape = left_matrix.shape(0);
-            const std::uint32_t left_stride = left_shape[1];
-            const std::uint32_t right_stride = right_shape[1];
-            for (std::uint32_t j = 0; j < shape; ++j)
-            {
-                sum += left_data[left_index] * right_data[right_index];
-                left_index += left_stride;
-                right_index += right_stride;
-            }
-            result.set(i, k, sum);
-        }
-    }
-    else if (!left_transpose && right_transpose)
-    {
-        for (std::uint32_t i = 0; i < left_matrix.shape(0); ++i)
-        {
-            left_index = i * left_shape[1];
-            right_index = k * right_shape[0];
-            Precision sum = 0;
-            const std::uint32_t shape = left_matrix.shape(1);
-            for (std::uint32_t j = 0; j < shape; ++j)
-            {
-                sum += left_data[left_index] * right_data[right_index];
-                left_index++;
-                right_index++;
-            }
-            result.set(i, k, sum);
-        }
-    }
-    else
-    {
-        for (std::uint32_t i = 0; i < left_matrix.shape(0); ++i)
-        {
-            left_index = i;
-            right_index = k * right_shape[0];
-            Precision sum = 0;
-            const std::uint32_t shape = left_matrix.shape(1);
-            const std::uint32_t left_stride = left_shape[1];
-            for (std::uint32_t j = 0; j < shape; ++j)
-            {
-                sum += left_data[left_index] * right_data[right_index];
-                left_index += left_stride;
-                right_index++;
-            }
-            result.set(i, k, sum);
-        }
-    }
-}
+Precision Matmul::msSparsityThreshold = 0.9;
+bool Matmul::msPackWeights = true;
+bool Matmul::msReducedWeights = false;
 
-void Matmul::matmul(const std::shared_ptr<Matrix>& left_matrix, const std::shared_ptr<Matrix>& right_matrix, const std::shared_ptr<Matrix>& result, const bool &left_transpose, const bool &right_transpose)
+const PackedMatrix *Matmul::packedWeights(const std::shared_ptr<Variable> &right, const bool transpose)
 {
-    //divide into threads
-    std::vector<std::thread> workers(right_matrix->shape(1));
-    Matrix &left_matrix_ref = *left_matrix;
-    Matrix &right_matrix_ref = *right_matrix;
-    Matrix &result_ref = *result;
-    for (std::uint32_t i = 0; i < right_matrix->shape(1); i++)
+    if (!msPackWeights || right->getOperation() != nullptr)
     {
-        workers[i] = std::thread (&Matmul::blockmul, this, std::ref(left_matrix_ref), std::ref(right_matrix_ref), std::ref(result_ref), i, std::ref(left_transpose), std::ref(right_transpose));
+        return nullptr;
     }
-    for (std::thread &worker:workers)
+    PackedWeights &cache = transpose ? mPackedWeightsTransposed : mPackedWeights;
+    const std::shared_ptr<Tensor> &source = right->getData();
+    if (cache.pMatrix == nullptr || cache.pSource != source || cache.version != right->getVersion() || cache.pMatrix->reduced() != msReducedWeights)
     {
-        worker.join(); // wait for all threads to finish
+        // B^T of a k x n matrix is n x k, stored as the k x n source
+        const std::uint64_t rows = transpose ? source->shape(1) : source->shape(0);
+        const std::uint64_t columns = transpose ? source->shape(0) : source->shape(1);
+        cache.pMatrix = std::make_shared<PackedMatrix>(source->data(), rows, columns, transpose, msReducedWeights);
+        cache.pSource = source;
+        cache.version = right->getVersion();
     }
+    return cache.pMatrix.get();
 }
 
 void Matmul::f(std::vector<std::shared_ptr<Variable>>& inputs)
@@ -122,7 +47,20 @@ void Matmul::f(std::vector<std::shared_ptr<Variable>>& inputs)
         this->getVariable()->setData(std::make_shared<Matrix>(Matrix({left_matrix->shape(0), right_matrix->shape(1)}, 0)));
     }
     std::shared_ptr<Matrix> result = std::static_pointer_cast<Matrix>(this->getVariable()->getData());
-    matmul(left_matrix, right_matrix, result);
+
+    // mostly zero inputs (e.g. bag of features) skip the zeros, the compressed matrix is kept for the weight gradient
+    mpSparseLeft = nullptr;
+    mpSparseSource = nullptr;
+    if (msSparsityThreshold <= 1 && SparseMatrix::sparsity(*left_matrix) > msSparsityThreshold)
+    {
+        mpSparseLeft = std::make_shared<SparseMatrix>(*left_matrix);
+        mpSparseSource = inputs[0]->getData();
+        mpSparseLeft->multiply(*right_matrix, *result);
+        return;
+    }
+    Gemm::Problem problem = {left_matrix->data(), right_matrix->data(), result->data(), left_matrix->shape(0), right_matrix->shape(1), left_matrix->shape(1)};
+    problem.packedB = packedWeights(inputs[1], false);
+    Gemm::multiply(problem);
 }
 
 std::shared_ptr<Tensor> Matmul::bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient)
@@ -141,16 +79,37 @@ std::shared_ptr<Tensor> Matmul::bprop(std::vector<std::shared_ptr<Variable>>& in
     std::shared_ptr<Matrix> gradient_matrix = static_pointer_cast<Matrix>(gradient);
     if (inputs[0]->getId() == focus->getId())
     {
-        std::shared_ptr<Matrix> right_matrix = std::static_pointer_cast<Matrix>(inputs[1]->getData()); // transposed version needed to output the correct shape
+        std::shared_ptr<Matrix> right_matrix = std::static_pointer_cast<Matrix>(inputs[1]->getData());
         std::shared_ptr<Matrix> result = std::make_shared<Matrix>(inputs[0]->getData()->shape(), 0);
-        matmul(gradient_matrix, right_matrix, result, false, true);
+        Gemm::Problem problem = {gradient_matrix->data(), right_matrix->data(), result->data(), result->shape(0), result->shape(1), gradient_matrix->shape(1)};
+        problem.transposeB = true; // transposed version needed to output the correct shape
+        problem.packedB = packedWeights(inputs[1], true);
+        Gemm::multiply(problem);
         return result;
     }
     else
     {
-        std::shared_ptr<Matrix> left_matrix = std::static_pointer_cast<Matrix>(inputs[0]->getData()); // transposed version needed to output the correct shape
         std::shared_ptr<Matrix> result = std::make_shared<Matrix>(inputs[1]->getData()->shape(), 0);
-        matmul(left_matrix, gradient_matrix, result, true, false);
+        if (mpSparseLeft != nullptr && mpSparseSource == inputs[0]->getData()) // the left matrix was sparse in the forward pass
+        {
+            mpSparseLeft->transposeMultiply(*gradient_matrix, *result);
+            return result;
+        }
+        std::shared_ptr<Matrix> left_matrix = std::static_pointer_cast<Matrix>(inputs[0]->getData());
+        Gemm::Problem problem = {left_matrix->data(), gradient_matrix->data(), result->data(), result->shape(0), result->shape(1), gradient_matrix->shape(0)};
+        problem.transposeA = true; // transposed version needed to output the correct shape
+        Gemm::multiply(problem);
         return result;
     }
+}
+
+void Matmul::setSparsityThreshold(const Precision threshold)
+{
+    msSparsityThreshold = threshold;
+}
+
+void Matmul::setWeightPacking(const bool enabled, const bool reduced)
+{
+    msPackWeights = enabled;
+    msReducedWeights = reduced;
 }
\ No newline at end of file
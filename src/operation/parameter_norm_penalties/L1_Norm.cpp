@@ -13,15 +13,11 @@ void L1Norm::f(std::vector<std::shared_ptr<Variable>>& inputs)
     auto input = inputs[0]->getData();
     auto result = std::make_shared<Tensor>(Tensor({1}));
 
-    double sum = 0;
-    for (std::uint32_t i = 0; i < input->capacity(); i++)
-    {
-        if ((i - 1) % input->shape(0) == 0) // no penalty on the bias
-        {
-            continue;
-        }
-        sum += std::abs(input->at({i}));
-    }
+    const Precision *pInput = input->data();
+    const size_t rows = input->shape(0);
+    const Precision sum = Reduction::sumOf(input->capacity(), [pInput, rows](const std::uint64_t i) {
+        return static_cast<std::uint32_t>(i - 1) % rows == 0 ? 0 : std::abs(pInput[i]); // no penalty on the bias
+    });
 
     result->set({0}, _lambda * sum);
 
@@ -24,15 +24,13 @@ void Dropout::f(std::vector<std::shared_ptr<Variable>>& inputs)
     }
     else
     {
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::bernoulli_distribution dist(mDropoutRate);
 
         mMask = std::vector<bool>(input->capacity());
 
         for(std::uint32_t i = 0; i < input->capacity(); i++)
         {
-            mMask[i] = dist(gen);
+            mMask[i] = dist(mGenerator);
             result->set({i}, input->at({i}) * mMask[i]);
         }
     }
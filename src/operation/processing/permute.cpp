@@ -0,0 +1,42 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+#include "operation/processing/permute.hpp"
+
+Permute::Permute(const std::vector<size_t> &axes) : mAxes(axes)
+{
+    std::vector<size_t> sorted = axes;
+    std::ranges::sort(sorted);
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        if (sorted[i] != i)
+        {
+            throw std::invalid_argument("Permute::Permute: The axes are not a permutation.");
+        }
+    }
+    mName = "PERMUTE";
+}
+
+void Permute::f(std::vector<std::shared_ptr<Variable>>& inputs)
+{
+    if (inputs.size() != 1)
+    {
+        throw std::invalid_argument("Permute::f: Invalid number of input variables.");
+    }
+    if (inputs.front()->getData()->dimensionality() != mAxes.size())
+    {
+        throw std::invalid_argument("Permute::f: The number of axes does not match the dimensionality of the input.");
+    }
+
+    this->getVariable()->getData() = std::make_shared<Tensor>(inputs.front()->getData()->permute(mAxes));
+}
+
+std::shared_ptr<Tensor> Permute::bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient)
+{
+    if (inputs.size() != 1)
+    {
+        throw std::invalid_argument("Permute::bprop: Invalid number of input variables.");
+    }
+
+    return std::make_shared<Tensor>(gradient->permute(Transpose::inverse(mAxes))); // undo the permutation
+}
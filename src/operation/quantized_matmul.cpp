@@ -0,0 +1,157 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+#include "operation/quantized_matmul.hpp"
+#include "parallel.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+QuantizedMatmul::QuantizedMatmul(const Tensor &weights, const Precision inputMinimum, const Precision inputMaximum)
+{
+    mName = "QUANTIZED_MATMUL";
+    if (weights.dimensionality() != 2 || weights.shape(0) < 2)
+    {
+        throw std::invalid_argument("QuantizedMatmul::QuantizedMatmul: The weights must be a matrix with a bias row.");
+    }
+    mDepth = weights.shape(0) - 1;
+    mPaddedDepth = (mDepth + msBlock - 1) / msBlock * msBlock;
+    mOutputs = weights.shape(1);
+
+    // the range always contains 0, so zeros (e.g. after ReLU) are represented exactly
+    const float minimum = std::min(static_cast<float>(inputMinimum), 0.0f);
+    const float maximum = std::max(static_cast<float>(inputMaximum), 0.0f);
+    mInputScale = maximum > minimum ? (maximum - minimum) / msInputLevels : 1.0f;
+    mInputZeroPoint = static_cast<std::int32_t>(std::lround(-minimum / mInputScale));
+
+    // symmetric per channel weights
+    const Precision *pWeights = weights.data();
+    mWeights.assign(mOutputs * mPaddedDepth, 0);
+    mColumnSums.assign(mOutputs, 0);
+    mWeightScales.assign(mOutputs, 1);
+    mBias.assign(pWeights + mDepth * mOutputs, pWeights + (mDepth + 1) * mOutputs);
+    for (std::uint64_t j = 0; j < mOutputs; j++)
+    {
+        float largest = 0;
+        for (std::uint64_t p = 0; p < mDepth; p++)
+        {
+            largest = std::max(largest, std::abs(static_cast<float>(pWeights[p * mOutputs + j])));
+        }
+        if (largest > 0)
+        {
+            mWeightScales[j] = largest / 127;
+        }
+        std::int8_t *pChannel = mWeights.data() + j * mPaddedDepth;
+        for (std::uint64_t p = 0; p < mDepth; p++)
+        {
+            pChannel[p] = static_cast<std::int8_t>(std::clamp<long>(std::lround(pWeights[p * mOutputs + j] / mWeightScales[j]), -127, 127));
+            mColumnSums[j] += pChannel[p];
+        }
+    }
+}
+
+void QuantizedMatmul::dot(const std::uint8_t *input, const std::uint64_t channel, std::int32_t *result) const
+{
+    const std::int8_t *pWeights = mWeights.data() + channel * mPaddedDepth;
+#if defined(__AVX2__)
+    __m256i sums[4] = {_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+#if !defined(__AVXVNNI__)
+    const __m256i ones = _mm256_set1_epi16(1);
+#endif
+    for (std::uint64_t p = 0; p < mPaddedDepth; p += msBlock)
+    {
+        const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + p));
+        for (std::uint32_t c = 0; c < 4; c++)
+        {
+            const __m256i weights = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pWeights + c * mPaddedDepth + p));
+#if defined(__AVXVNNI__)
+            sums[c] = _mm256_dpbusd_avx_epi32(sums[c], values, weights);
+#else
+            sums[c] = _mm256_add_epi32(sums[c], _mm256_madd_epi16(_mm256_maddubs_epi16(values, weights), ones));
+#endif
+        }
+    }
+    for (std::uint32_t c = 0; c < 4; c++)
+    {
+        const __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sums[c]), _mm256_extracti128_si256(sums[c], 1));
+        const __m128i quarter = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+        result[c] = _mm_cvtsi128_si32(_mm_add_epi32(quarter, _mm_shuffle_epi32(quarter, 0xB1)));
+    }
+#else
+    for (std::uint32_t c = 0; c < 4; c++)
+    {
+        std::int32_t sum = 0;
+        for (std::uint64_t p = 0; p < mDepth; p++)
+        {
+            sum += static_cast<std::int32_t>(input[p]) * pWeights[c * mPaddedDepth + p];
+        }
+        result[c] = sum;
+    }
+#endif
+}
+
+void QuantizedMatmul::f(std::vector<std::shared_ptr<Variable>>& inputs)
+{
+    if (inputs.size() != 2)
+    {
+        throw std::invalid_argument("QuantizedMatmul::f: Invalid number of input variables.");
+    }
+    const std::shared_ptr<Tensor> &input = inputs[0]->getData();
+    if (input->dimensionality() != 2 || input->shape(1) != mDepth + 1)
+    {
+        throw std::invalid_argument("QuantizedMatmul::f: The input does not match the quantized weights.");
+    }
+    const std::uint64_t rows = input->shape(0);
+    if (this->getVariable()->getData() == nullptr || this->getVariable()->getData()->capacity() != rows * mOutputs)
+    {
+        this->getVariable()->setData(std::make_shared<Matrix>(Matrix({rows, mOutputs}, 0)));
+    }
+    const Precision *pInput = input->data();
+    Precision *pResult = this->getVariable()->getData()->data();
+
+    Parallel::forRange(rows, rows * mOutputs * mDepth / 8, [&](const std::uint64_t begin, const std::uint64_t end) {
+        std::vector<std::uint8_t> row(mPaddedDepth, 0);
+        std::int32_t sums[4];
+        for (std::uint64_t i = begin; i < end; i++)
+        {
+            const Precision *pRow = pInput + i * (mDepth + 1);
+            for (std::uint64_t p = 0; p < mDepth; p++)
+            {
+                row[p] = static_cast<std::uint8_t>(std::clamp<long>(std::lround(pRow[p] / mInputScale) + mInputZeroPoint, 0, msInputLevels));
+            }
+
+            // dequantize and add the bias while the sums are in registers
+            Precision *pOutput = pResult + i * mOutputs;
+            const float bias = pRow[mDepth]; // the padding, 1 for dense layers
+            std::uint64_t j = 0;
+            for (; j + 4 <= mOutputs; j += 4)
+            {
+                dot(row.data(), j, sums);
+                for (std::uint32_t c = 0; c < 4; c++)
+                {
+                    pOutput[j + c] = static_cast<Precision>(mInputScale * mWeightScales[j + c] * static_cast<float>(sums[c] - mInputZeroPoint * mColumnSums[j + c]) + bias * mBias[j + c]);
+                }
+            }
+            for (; j < mOutputs; j++) // the last channels do not fill a group of four
+            {
+                std::int32_t sum = 0;
+                for (std::uint64_t p = 0; p < mDepth; p++)
+                {
+                    sum += static_cast<std::int32_t>(row[p]) * mWeights[j * mPaddedDepth + p];
+                }
+                pOutput[j] = static_cast<Precision>(mInputScale * mWeightScales[j] * static_cast<float>(sum - mInputZeroPoint * mColumnSums[j]) + bias * mBias[j]);
+            }
+        }
+    });
+}
+
+std::shared_ptr<Tensor> QuantizedMatmul::bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient)
+{
+    throw std::runtime_error("QuantizedMatmul::bprop: Quantized layers can only be used for inference.");
+}
+
+std::uint64_t QuantizedMatmul::bytes() const
+{
+    return mWeights.size() * sizeof(std::int8_t) + (mColumnSums.size() + mWeightScales.size()) * 4 + mBias.size() * sizeof(Precision);
+}
@@ -0,0 +1,143 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+#include "operation/sharded_matmul.hpp"
+
+ShardedMatmul::ShardedMatmul(const std::uint32_t shards) : mShards(shards)
+{
+    if (shards == 0)
+    {
+        throw std::invalid_argument("ShardedMatmul::ShardedMatmul: At least one shard is needed.");
+    }
+    mpTeam = std::make_shared<ThreadTeam>(shards, 1, ThreadTeam::claimCores(shards)); // other teams, e.g. of the next sharded layer, use other cores
+    mLocalWeights.resize(shards);
+    mPartialResults.resize(shards);
+    mGradientShards.resize(shards);
+    mWeightGradients.resize(shards);
+    mName = "SHARDED_MATMUL";
+}
+
+std::vector<std::uint64_t> ShardedMatmul::offsets(std::vector<std::shared_ptr<Variable>> &inputs)
+{
+    std::vector<std::uint64_t> result = {0};
+    for (size_t s = 1; s < inputs.size(); s++)
+    {
+        if (inputs[s]->getData()->shape(0) != inputs[0]->getData()->shape(1))
+        {
+            throw std::invalid_argument("ShardedMatmul: Invalid shapes of input matrices.");
+        }
+        result.push_back(result.back() + inputs[s]->getData()->shape(1));
+    }
+    return result;
+}
+
+void ShardedMatmul::f(std::vector<std::shared_ptr<Variable>>& inputs)
+{
+    if (inputs.size() != mShards + 1)
+    {
+        throw std::invalid_argument("ShardedMatmul::f: Invalid number of input variables.");
+    }
+    const std::vector<std::uint64_t> columns = offsets(inputs);
+    const std::shared_ptr<Tensor> &left = inputs[0]->getData();
+    const std::uint64_t rows = left->shape(0);
+    const std::uint64_t depth = left->shape(1);
+    const std::uint64_t width = columns.back();
+    if (this->getVariable()->getData() == nullptr || this->getVariable()->getData()->capacity() != rows * width)
+    {
+        this->getVariable()->setData(std::make_shared<Matrix>(Matrix({rows, width}, 0)));
+    }
+    Precision *pResult = this->getVariable()->getData()->data();
+
+    mpTeam->run([&](const std::uint32_t s) {
+        Parallel::setLocalThreadCount(1); // the member is one thread, the tuned configuration is chosen for one thread
+        const std::shared_ptr<Variable> &weights = inputs[s + 1];
+        LocalWeights &local = mLocalWeights[s];
+        if (weights->getData() != local.pSource || weights->getVersion() != local.version) // changed weights, the member copies them into its memory
+        {
+            local.values.assign(weights->getData()->data(), weights->getData()->data() + weights->getData()->capacity());
+            local.pSource = weights->getData();
+            local.version = weights->getVersion();
+        }
+
+        const std::uint64_t shardColumns = columns[s + 1] - columns[s];
+        mPartialResults[s].resize(rows * shardColumns);
+        Gemm::multiply({left->data(), local.values.data(), mPartialResults[s].data(), rows, shardColumns, depth});
+        for (std::uint64_t i = 0; i < rows; i++) // gather
+        {
+            std::copy_n(mPartialResults[s].data() + i * shardColumns, shardColumns, pResult + i * width + columns[s]);
+        }
+    });
+}
+
+void ShardedMatmul::backward(std::vector<std::shared_ptr<Variable>> &inputs, const std::shared_ptr<Tensor> &gradient)
+{
+    const std::vector<std::uint64_t> columns = offsets(inputs);
+    const std::shared_ptr<Tensor> &left = inputs[0]->getData();
+    const std::uint64_t rows = left->shape(0);
+    const std::uint64_t depth = left->shape(1);
+    const std::uint64_t width = columns.back();
+    const Precision *pGradient = gradient->data();
+
+    mpTeam->run([&](const std::uint32_t s) {
+        Parallel::setLocalThreadCount(1);
+        const std::uint64_t shardColumns = columns[s + 1] - columns[s];
+        std::vector<Precision> &gradientShard = mGradientShards[s];
+        gradientShard.resize(rows * shardColumns);
+        for (std::uint64_t i = 0; i < rows; i++) // scatter
+        {
+            std::copy_n(pGradient + i * width + columns[s], shardColumns, gradientShard.data() + i * shardColumns);
+        }
+
+        // X^T G_s
+        mWeightGradients[s] = std::make_shared<Matrix>(Matrix({depth, shardColumns}, 0));
+        Gemm::Problem problem = {left->data(), gradientShard.data(), mWeightGradients[s]->data(), depth, shardColumns, rows};
+        problem.transposeA = true;
+        Gemm::multiply(problem);
+
+        // G_s W_s^T, with the weights of the forward pass
+        mPartialResults[s].resize(rows * depth);
+        problem = {gradientShard.data(), mLocalWeights[s].values.data(), mPartialResults[s].data(), rows, depth, shardColumns};
+        problem.transposeB = true;
+        Gemm::multiply(problem);
+    });
+
+    // sum the parts in shard order
+    mpInputGradient = std::make_shared<Matrix>(Matrix({rows, depth}, 0));
+    Precision *pInputGradient = mpInputGradient->data();
+    Parallel::forRange(rows * depth, rows * depth * mShards, [&](const std::uint64_t begin, const std::uint64_t end) {
+        for (std::uint32_t s = 0; s < mShards; s++)
+        {
+            const Precision *pPart = mPartialResults[s].data();
+            for (std::uint64_t i = begin; i < end; i++)
+            {
+                pInputGradient[i] += pPart[i];
+            }
+        }
+    });
+    mpGradientSource = gradient;
+}
+
+std::shared_ptr<Tensor> ShardedMatmul::bprop(std::vector<std::shared_ptr<Variable>>& inputs, std::shared_ptr<Variable> & focus, std::shared_ptr<Tensor> & gradient)
+{
+    if (inputs.size() != mShards + 1)
+    {
+        throw std::invalid_argument("ShardedMatmul::bprop: Invalid number of input variables.");
+    }
+    if (gradient != mpGradientSource) // first call of this backward pass
+    {
+        backward(inputs, gradient);
+    }
+
+    if (inputs[0]->getId() == focus->getId())
+    {
+        return mpInputGradient;
+    }
+    for (std::uint32_t s = 0; s < mShards; s++)
+    {
+        if (inputs[s + 1]->getId() == focus->getId())
+        {
+            return mWeightGradients[s];
+        }
+    }
+    throw std::invalid_argument("ShardedMatmul::bprop: The focus variable is not an input variable.");
+}
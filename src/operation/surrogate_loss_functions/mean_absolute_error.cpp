@@ -20,11 +20,11 @@ void MeanAbsoluteError::f(std::vector<std::shared_ptr<Variable>>& inputs)
     }
 
     // calculate the mean absolute error
-    double sum = 0;
-    for(std::uint32_t i = 0; i < inputs[0]->getData()->capacity(); i++)
-    {
-        sum += abs(inputs[0]->getData()->at(i) - inputs[1]->getData()->at(i));
-    }
+    const Precision *pPrediction = inputs[0]->getData()->data();
+    const Precision *pTarget = inputs[1]->getData()->data();
+    Precision sum = Reduction::sumOf(inputs[0]->getData()->capacity(), [&](const std::uint64_t i) {
+        return std::abs(pPrediction[i] - pTarget[i]);
+    });
     sum /= inputs[0]->getData()->capacity();
     // store the result
     this->getVariable()->getData() = std::make_shared<Tensor>(Tensor({1},sum));
@@ -20,11 +20,12 @@ void MSE::f(std::vector<std::shared_ptr<Variable>>& inputs)
     }
 
     // calculate the mean squared error
-    double sum = 0;
-    for(std::uint32_t i = 0; i < inputs[0]->getData()->capacity(); i++)
-    {
-        sum += pow(inputs[0]->getData()->at(i) - inputs[1]->getData()->at(i), 2)/2;
-    }
+    const Precision *pPrediction = inputs[0]->getData()->data();
+    const Precision *pTarget = inputs[1]->getData()->data();
+    Precision sum = Reduction::sumOf(inputs[0]->getData()->capacity(), [&](const std::uint64_t i) {
+        const Precision difference = pPrediction[i] - pTarget[i];
+        return difference * difference / 2;
+    });
     sum /= inputs[0]->getData()->capacity();
     // store the result
     this->getVariable()->getData() = std::make_shared<Tensor>(Tensor({1},sum));
@@ -3,7 +3,7 @@
 //
 #include "operation/weight_initialization/he_initialization.hpp"
 
-double HeInitialization::generate()
+Precision HeInitialization::generate()
 {
     return mDist(mGen);
 }
@@ -14,6 +14,6 @@ void HeInitialization::createRandomEngine(std::uint32_t inputUnits, std::uint32_
     mOutputUnits = outputUnits;
     mLowerBound = -std::sqrt(6.0 / (inputUnits));
     mUpperBound = std::sqrt(6.0 / (outputUnits));
-    mGen = std::mt19937(mRd());
+    mGen = Random::generator(Random::Stream::INITIALIZATION);
     mDist = std::uniform_real_distribution<double>(mLowerBound, mUpperBound);
 }
\ No newline at end of file
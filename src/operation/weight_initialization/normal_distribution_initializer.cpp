@@ -3,7 +3,7 @@
 //
 #include "operation/weight_initialization/normal_distribution_initializer.hpp"
 
-double NormalDistributionInitializer::generate()
+Precision NormalDistributionInitializer::generate()
 {
     std::normal_distribution<double> dist(mMean, mStdDev);
     return dist(mGen);
@@ -13,7 +13,7 @@ void NormalDistributionInitializer::createRandomEngine(std::uint32_t inputUnits,
 {
     mInputUnits = inputUnits;
     mOutputUnits = outputUnits;
-    mGen = std::mt19937(mRd());
+    mGen = Random::generator(Random::Stream::INITIALIZATION);
     mDist = std::normal_distribution<double>(mMean, mStdDev);
 }
 
@@ -3,7 +3,7 @@
 //
 #include "operation/weight_initialization/normalized_initialization.hpp"
 
-double NormalizedInitialization::generate()
+Precision NormalizedInitialization::generate()
 {
     return mDist(mGen);
 }
@@ -14,6 +14,6 @@ void NormalizedInitialization::createRandomEngine(std::uint32_t inputUnits, std:
     mOutputUnits = outputUnits;
     mLowerBound = -std::sqrt(6.0 / (inputUnits + outputUnits));
     mUpperBound = std::sqrt(6.0 / (inputUnits + outputUnits));
-    mGen = std::mt19937(mRd());
+    mGen = Random::generator(Random::Stream::INITIALIZATION);
     mDist = std::uniform_real_distribution<double>(mLowerBound, mUpperBound);
 }
\ No newline at end of file
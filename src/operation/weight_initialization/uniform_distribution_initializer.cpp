@@ -3,7 +3,7 @@
 //
 #include "operation/weight_initialization/uniform_distribution_initializer.hpp"
 
-double UniformDistributionInitializer::generate()
+Precision UniformDistributionInitializer::generate()
 {
     return mDist(mGen);
 }
@@ -12,7 +12,7 @@ void UniformDistributionInitializer::createRandomEngine(std::uint32_t inputUnits
 {
     mInputUnits = inputUnits;
     mOutputUnits = outputUnits;
-    mGen = std::mt19937(mRd());
+    mGen = Random::generator(Random::Stream::INITIALIZATION);
     mDist = std::uniform_real_distribution<double>(mLowerBound, mUpperBound);
 }
 
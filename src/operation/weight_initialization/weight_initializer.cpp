@@ -3,11 +3,16 @@
 //
 #include "operation/weight_initialization/weight_initializer.hpp"
 
-std::vector<double> WeightInitializer::createRandomVector()
+std::vector<Precision> WeightInitializer::createRandomVector()
 {
-    std::vector<double> output(mInputUnits * mOutputUnits);
+    return createRandomVector(static_cast<std::uint64_t>(mInputUnits) * mOutputUnits);
+}
 
-    for (std::uint32_t i = 0; i < mInputUnits * mOutputUnits; i++)
+std::vector<Precision> WeightInitializer::createRandomVector(const std::uint64_t size)
+{
+    std::vector<Precision> output(size);
+
+    for (std::uint64_t i = 0; i < size; i++)
     {
         output[i] = generate();
     }
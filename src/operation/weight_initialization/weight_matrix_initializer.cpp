@@ -8,8 +8,8 @@ void WeightMatrixInitializer::createWeightMatrix(std::uint32_t n, std::uint32_t
     getVariable()->getData() = std::make_shared<Tensor>(Tensor({n, m})); // initialize the weights randomly
 
     // initialize the weights randomly
-    mpWeightInitializer->createRandomEngine(n-1, m);
-    const std::vector<double> weights = mpWeightInitializer->createRandomVector();
+    mpWeightInitializer->createRandomEngine(n-1, mOutputUnits);
+    const std::vector<Precision> weights = mpWeightInitializer->createRandomVector(static_cast<std::uint64_t>(n - 1) * m);
 
     for (std::uint32_t i = 0; i < n-1; i++) // load the weights into the weight matrix
     {
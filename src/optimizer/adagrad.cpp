@@ -42,5 +42,6 @@ void AdaGrad::update(const std::vector<std::shared_ptr<Variable>> & rLearnablePa
             mSquaredGradients[i].add(j, gradient->at(j) * gradient->at(j));
             rLearnableParameters[i]->getData()->subtract(j, mLearningRate * gradient->at(j) / (std::sqrt(mSquaredGradients[i].at(j)) + mDelta));
         }
+        rLearnableParameters[i]->bumpVersion();
     }
 }
\ No newline at end of file
@@ -57,5 +57,6 @@ void Adam::update(const std::vector<std::shared_ptr<Variable>> & rLearnableParam
             double secondMomentEstimateBiasCorrected = mSecondMomentEstimates[i].at(j) / (1 - std::pow(mDecayRate2, mIteration));
             rLearnableParameters[i]->getData()->subtract(j, mLearningRate * firstMomentEstimateBiasCorrected / (std::sqrt(secondMomentEstimateBiasCorrected) + mDelta));
         }
+        rLearnableParameters[i]->bumpVersion();
     }
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+#include "optimizer/loss_scaler.hpp"
+
+LossScaler::LossScaler(const double initialScale, const double growthFactor, const double backoffFactor, const std::uint32_t growthInterval) :
+mScale(initialScale), mGrowthFactor(growthFactor), mBackoffFactor(backoffFactor), mGrowthInterval(growthInterval)
+{
+    if (mScale <= 0 || mGrowthFactor < 1 || mBackoffFactor <= 0 || mBackoffFactor >= 1 || mGrowthInterval == 0)
+    {
+        throw std::invalid_argument("LossScaler::LossScaler: The scale must be positive, the growth factor at least 1, the backoff factor in (0, 1) and the growth interval positive");
+    }
+}
+
+double LossScaler::scale() const
+{
+    return mScale;
+}
+
+bool LossScaler::unscale(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters)
+{
+    std::vector<std::shared_ptr<Tensor>> gradients;
+    for (const auto & rLearnableParameter : rLearnableParameters)
+    {
+        gradients.push_back(GRAPH->getGradient(rLearnableParameter));
+        const Precision *pGradient = gradients.back()->data();
+        if (!std::all_of(pGradient, pGradient + gradients.back()->capacity(), [](const Precision value) { return std::isfinite(value); }))
+        {
+            mScale = std::max(mScale * mBackoffFactor, std::numeric_limits<double>::min());
+            mGoodSteps = 0;
+            mSkippedSteps++;
+            return false;
+        }
+    }
+
+    const auto inverse = static_cast<Precision>(1 / mScale);
+    for (const std::shared_ptr<Tensor> &gradient : gradients)
+    {
+        Precision *pGradient = gradient->data();
+        for (std::size_t j = 0; j < gradient->capacity(); j++)
+        {
+            pGradient[j] *= inverse;
+        }
+    }
+
+    if (++mGoodSteps >= mGrowthInterval)
+    {
+        mScale *= mGrowthFactor;
+        mGoodSteps = 0;
+    }
+    return true;
+}
+
+std::uint64_t LossScaler::skippedSteps() const
+{
+    return mSkippedSteps;
+}
@@ -14,6 +14,11 @@ Momentum::Momentum(double learningRate, double momentum, std::vector<Tensor> ini
 
 void Momentum::init(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters)
 {
+    if (mInitialized)
+    {
+        return;
+    }
+    mInitialized = true;
     if (mVelocity.empty())
     {
         for (const auto & rLearnableParameter : rLearnableParameters)
@@ -29,11 +34,7 @@ void Momentum::init(const std::vector<std::shared_ptr<Variable>> & rLearnablePar
 
 void Momentum::update(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters)
 {
-    if (!mInitialized)
-    {
-        init(rLearnableParameters);
-        mInitialized = true;
-    }
+    init(rLearnableParameters);
     for (std::size_t i = 0; i < rLearnableParameters.size(); i++)
     {
         std::shared_ptr<Tensor> gradient = GRAPH->getGradient(rLearnableParameters[i]);
@@ -43,5 +44,33 @@ void Momentum::update(const std::vector<std::shared_ptr<Variable>> & rLearnableP
             mVelocity[i].set(j, mMomentum * mVelocity[i].at(j) - mLearningRate * gradient->at(j));
             rLearnableParameters[i]->getData()->add(j, mVelocity[i].at(j));
         }
+        rLearnableParameters[i]->bumpVersion();
+    }
+}
+
+void Momentum::updateShared(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters, const std::vector<std::shared_ptr<Tensor>> & rGradients)
+{
+    if (!mInitialized || mVelocity.size() != rLearnableParameters.size())
+    {
+        throw std::invalid_argument("Momentum::updateShared: The velocity must be initialized for the shared parameters.");
+    }
+    for (std::size_t i = 0; i < rLearnableParameters.size(); i++)
+    {
+        if (rGradients[i] == nullptr)
+        {
+            continue;
+        }
+        Precision *pParameter = rLearnableParameters[i]->getData()->data();
+        Precision *pVelocity = mVelocity[i].data();
+        const Precision *pGradient = rGradients[i]->data();
+
+        for (std::size_t j = 0; j < rGradients[i]->capacity(); j++)
+        {
+            std::atomic_ref<Precision> velocity(pVelocity[j]);
+            std::atomic_ref<Precision> parameter(pParameter[j]);
+            const Precision step = mMomentum * velocity.load(std::memory_order_relaxed) - mLearningRate * pGradient[j];
+            velocity.store(step, std::memory_order_relaxed);
+            parameter.store(parameter.load(std::memory_order_relaxed) + step, std::memory_order_relaxed);
+        }
     }
 }
\ No newline at end of file
@@ -32,6 +32,7 @@ void NesterovMomentum::init(const std::vector<std::shared_ptr<Variable>> & rLear
         {
             rLearnableParameters[i]->getData()->add(j, mMomentum * mVelocity[i].at(j));
         }
+        rLearnableParameters[i]->bumpVersion();
     }
 }
 
@@ -52,5 +53,6 @@ void NesterovMomentum::update(const std::vector<std::shared_ptr<Variable>> & rLe
             mVelocity[i].set(j, mMomentum * mVelocity[i].at(j) - mLearningRate * gradient->at(j));
             rLearnableParameters[i]->getData()->add(j, mVelocity[i].at(j) * (1 + mMomentum));
         }
+        rLearnableParameters[i]->bumpVersion();
     }
 }
\ No newline at end of file
@@ -42,5 +42,6 @@ void RMSProp::update(const std::vector<std::shared_ptr<Variable>> & rLearnablePa
             mCache[i].set(j, mDecayRate * mCache[i].at(j) + (1 - mDecayRate) * std::pow(gradient->at(j), 2));
             rLearnableParameters[i]->getData()->subtract(j, mLearningRate * gradient->at(j) / (std::sqrt(mCache[i].at(j)) + mDelta));
         }
+        rLearnableParameters[i]->bumpVersion();
     }
 }
\ No newline at end of file
@@ -43,6 +43,7 @@ void RMSPropNesterov::init(const std::vector<std::shared_ptr<Variable>> & rLearn
         {
             rLearnableParameters[i]->getData()->add(j, mMomentum * mVelocity[i].at(j));
         }
+        rLearnableParameters[i]->bumpVersion();
     }
 }
 
@@ -64,5 +65,6 @@ void RMSPropNesterov::update(const std::vector<std::shared_ptr<Variable>> & rLea
             mVelocity[i].set(j, mMomentum * mVelocity[i].at(j) - mLearningRate * gradient->at(j) / (std::sqrt(mCache[i].at(j)) + mDelta));
             rLearnableParameters[i]->getData()->add(j, mVelocity[i].at(j) * (1 + mMomentum));
         }
+        rLearnableParameters[i]->bumpVersion();
     }
 }
\ No newline at end of file
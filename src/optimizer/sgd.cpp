@@ -19,18 +19,19 @@ SGD::SGD(Precision initialLearningRate, std::uint32_t lastDecay) : SGD(initialLe
 {
 }
 
-void SGD::update(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters)
+Precision SGD::mLearningRate(const Precision iteration) const
 {
-    Precision learningRate;
-    if(mIteration > mLastDecay)
-    {
-        learningRate = mFinalLearningRate;
-    }
-    else
+    if(iteration > mLastDecay)
     {
-        Precision decay = mIteration / mLastDecay;
-        learningRate = (1 - decay) * mInitialLearningRate + decay * mFinalLearningRate;
+        return mFinalLearningRate;
     }
+    Precision decay = iteration / mLastDecay;
+    return (1 - decay) * mInitialLearningRate + decay * mFinalLearningRate;
+}
+
+void SGD::update(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters)
+{
+    Precision learningRate = mLearningRate(mIteration);
     for(const auto & rLearnableParameter : rLearnableParameters)
     {
         Tensor &parameterGradient = *GRAPH->getGradient(rLearnableParameter);
@@ -40,6 +41,30 @@ void SGD::update(const std::vector<std::shared_ptr<Variable>> & rLearnableParame
         {
             parameter.subtract(j, learningRate * parameterGradient.at(j));
         }
+        rLearnableParameter->bumpVersion();
     }
     mIteration++;
+}
+
+void SGD::updateShared(const std::vector<std::shared_ptr<Variable>> & rLearnableParameters, const std::vector<std::shared_ptr<Tensor>> & rGradients)
+{
+    const Precision learningRate = mLearningRate(std::atomic_ref<Precision>(mIteration).fetch_add(1, std::memory_order_relaxed));
+    for(std::size_t i = 0; i < rLearnableParameters.size(); i++)
+    {
+        if(rGradients[i] == nullptr)
+        {
+            continue;
+        }
+        Precision *pParameter = rLearnableParameters[i]->getData()->data();
+        const Precision *pGradient = rGradients[i]->data();
+
+        for(std::uint64_t j = 0; j < rGradients[i]->capacity(); ++j)
+        {
+            if(pGradient[j] != 0) // sparse gradients leave most of the shared cache lines alone
+            {
+                std::atomic_ref<Precision> parameter(pParameter[j]);
+                parameter.store(parameter.load(std::memory_order_relaxed) - learningRate * pGradient[j], std::memory_order_relaxed);
+            }
+        }
+    }
 }
\ No newline at end of file
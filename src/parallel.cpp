@@ -0,0 +1,194 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "parallel.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+std::uint32_t Parallel::msThreadCount = 0;
+thread_local std::uint32_t Parallel::msLocalThreadCount = 0;
+
+std::uint32_t Parallel::threadCount()
+{
+    if (msLocalThreadCount != 0)
+    {
+        return msLocalThreadCount;
+    }
+    if (msThreadCount != 0)
+    {
+        return msThreadCount;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void Parallel::setThreadCount(const std::uint32_t threads)
+{
+    msThreadCount = threads;
+}
+
+void Parallel::setLocalThreadCount(const std::uint32_t threads)
+{
+    msLocalThreadCount = threads;
+}
+
+void Parallel::forRange(const std::uint64_t size, const std::uint64_t work, const std::function<void(std::uint64_t, std::uint64_t)> &function)
+{
+    const std::uint64_t threads = std::min<std::uint64_t>({threadCount(), size, work / msMinimumWork + 1});
+    if (threads <= 1) // not worth spawning threads
+    {
+        function(0, size);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    const std::uint64_t chunk = (size + threads - 1) / threads;
+    for (std::uint64_t begin = chunk; begin < size; begin += chunk)
+    {
+        workers.emplace_back(function, begin, std::min(size, begin + chunk));
+    }
+    function(0, std::min(size, chunk)); // the calling thread does the first part
+    for (std::thread &worker : workers)
+    {
+        worker.join(); // wait for all threads to finish
+    }
+}
+
+void Parallel::forEach(const std::uint64_t count, const std::uint64_t work, const std::function<void(std::uint64_t)> &function, const std::uint32_t maximumThreads)
+{
+    const std::uint32_t limit = maximumThreads == 0 ? threadCount() : std::min(maximumThreads, threadCount());
+    const std::uint64_t threads = std::min<std::uint64_t>({limit, count, work / msMinimumWork + 1});
+    if (threads <= 1)
+    {
+        for (std::uint64_t i = 0; i < count; i++)
+        {
+            function(i);
+        }
+        return;
+    }
+
+    std::atomic<std::uint64_t> next = 0;
+    auto worker = [&]() {
+        for (std::uint64_t i = next.fetch_add(1, std::memory_order_relaxed); i < count; i = next.fetch_add(1, std::memory_order_relaxed))
+        {
+            function(i);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::uint64_t i = 1; i < threads; i++)
+    {
+        workers.emplace_back(worker);
+    }
+    worker(); // the calling thread claims items as well
+    for (std::thread &thread : workers)
+    {
+        thread.join(); // wait for all threads to finish
+    }
+}
+
+std::atomic<std::uint32_t> ThreadTeam::msNextCore = 0;
+
+std::uint32_t ThreadTeam::claimCores(const std::uint32_t count)
+{
+    const std::uint32_t cores = std::max(1u, std::thread::hardware_concurrency());
+    return msNextCore.fetch_add(count, std::memory_order_relaxed) % cores;
+}
+
+std::uint32_t ThreadTeam::coreShare(const std::uint32_t size)
+{
+    return std::max(1u, std::max(1u, std::thread::hardware_concurrency()) / std::max(1u, size));
+}
+
+ThreadTeam::ThreadTeam(const std::uint32_t size, const std::uint32_t coresPerMember, const std::uint32_t firstCore)
+{
+    if (size == 0)
+    {
+        throw std::invalid_argument("ThreadTeam::ThreadTeam: A team needs at least one member.");
+    }
+    const std::uint32_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const std::uint32_t width = std::min(cores, std::max(1u, coresPerMember));
+    for (std::uint32_t member = 0; member < size; member++)
+    {
+        mThreads.emplace_back(&ThreadTeam::work, this, member);
+#if defined(__linux__)
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        const std::uint64_t first = firstCore + static_cast<std::uint64_t>(member) * width; // neighbouring groups of cores, wrapping around
+        for (std::uint64_t core = first; core < first + width; core++)
+        {
+            CPU_SET(core % cores, &cpus);
+        }
+        pthread_setaffinity_np(mThreads.back().native_handle(), sizeof(cpu_set_t), &cpus); // best effort, e.g. fails in restricted containers
+#endif
+    }
+}
+
+ThreadTeam::~ThreadTeam()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mStart.notify_all();
+    for (std::thread &thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+std::uint32_t ThreadTeam::size() const
+{
+    return mThreads.size();
+}
+
+void ThreadTeam::work(const std::uint32_t member)
+{
+    std::uint64_t generation = 0;
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mStart.wait(lock, [&]() { return mStop || mGeneration != generation; });
+        if (mStop)
+        {
+            return;
+        }
+        generation = mGeneration;
+        lock.unlock();
+
+        try
+        {
+            mTask(member);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> errorLock(mMutex);
+            if (mpError == nullptr)
+            {
+                mpError = std::current_exception();
+            }
+        }
+
+        lock.lock();
+        if (--mRunning == 0)
+        {
+            mDone.notify_one();
+        }
+    }
+}
+
+void ThreadTeam::run(const std::function<void(std::uint32_t)> &task)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mTask = task;
+    mRunning = mThreads.size();
+    mpError = nullptr;
+    mGeneration++;
+    mStart.notify_all();
+    mDone.wait(lock, [&]() { return mRunning == 0; });
+    if (mpError != nullptr)
+    {
+        std::rethrow_exception(mpError);
+    }
+}
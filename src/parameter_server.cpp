@@ -0,0 +1,370 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "parameter_server.hpp"
+#include "parallel.hpp"
+#include "operation/sharded_matmul.hpp"
+
+#if defined(__unix__)
+#include <cerrno>
+#include <poll.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+ParameterServer::ParameterServer(const std::uint32_t workers, const std::uint32_t staleness) :
+mWorkerCount(workers),
+mStaleness(staleness),
+mCoresPerWorker(ThreadTeam::coreShare(workers))
+{
+#if !defined(__unix__)
+    throw std::invalid_argument("ParameterServer::ParameterServer: Worker processes require a POSIX system.");
+#endif
+    if (workers == 0)
+    {
+        throw std::invalid_argument("ParameterServer::ParameterServer: At least one worker is needed.");
+    }
+}
+
+#if defined(__unix__)
+
+void ParameterServer::mSend(const int socket, const void *pData, std::uint64_t bytes)
+{
+    const char *pBytes = static_cast<const char *>(pData);
+    while (bytes > 0)
+    {
+        const ssize_t sent = send(socket, pBytes, bytes, MSG_NOSIGNAL); // no SIGPIPE if the other side is gone
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent <= 0)
+        {
+            throw std::runtime_error("ParameterServer::mSend: The connection to the other process was lost.");
+        }
+        pBytes += sent;
+        bytes -= sent;
+    }
+}
+
+bool ParameterServer::mReceive(const int socket, void *pData, std::uint64_t bytes)
+{
+    char *pBytes = static_cast<char *>(pData);
+    while (bytes > 0)
+    {
+        const ssize_t received = read(socket, pBytes, bytes);
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received < 0)
+        {
+            throw std::runtime_error("ParameterServer::mReceive: Reading from the other process failed.");
+        }
+        if (received == 0)
+        {
+            return false;
+        }
+        pBytes += received;
+        bytes -= received;
+    }
+    return true;
+}
+
+void ParameterServer::mWork(const int socket, const std::uint32_t worker, const std::uint32_t batches, Dataset &dataset, const std::uint32_t batchSize, std::vector<VariablePtr> graphInputs, std::vector<VariablePtr> learnableVariables, std::vector<VariablePtr> gradientVariables, const std::vector<VariablePtr> &lossVariables) const
+{
+#if defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    const std::uint32_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const std::uint64_t first = static_cast<std::uint64_t>(worker) * cores / mWorkerCount; // spread the workers over the cores
+    for (std::uint64_t core = first; core < std::min<std::uint64_t>(cores, first + mCoresPerWorker); core++)
+    {
+        CPU_SET(core, &cpus);
+    }
+    sched_setaffinity(0, sizeof(cpu_set_t), &cpus); // best effort, e.g. fails in restricted containers
+#endif
+    Parallel::setThreadCount(mCoresPerWorker);
+
+    const std::uint32_t workers = std::min(mWorkerCount, batches); // as many as the server started
+    std::vector<Precision> buffer;
+    std::uint64_t version = 0; // the number of updates the weights of the worker include
+    std::shared_ptr<Tensor> data;
+    std::shared_ptr<Tensor> labels;
+    for (std::uint32_t batch = worker; batch < batches; batch += workers)
+    {
+        dataset.gatherTrainingBatch(batch * batchSize, batchSize, data, labels);
+        graphInputs[0]->setData(data);
+        graphInputs[1]->setData(labels);
+        GRAPH->forward(graphInputs);
+        GRAPH->backprop(learnableVariables, gradientVariables, 1.0 / batchSize);
+
+        buffer.clear();
+        for (const VariablePtr &pVar : learnableVariables)
+        {
+            const std::shared_ptr<Tensor> gradient = GRAPH->getGradient(pVar);
+            buffer.insert(buffer.end(), gradient->data(), gradient->data() + gradient->capacity());
+        }
+        const Push push = {batch, version, lossVariables[0]->getData()->at(0), lossVariables[1]->getData()->at(0)};
+        mSend(socket, &push, sizeof(Push));
+        mSend(socket, buffer.data(), buffer.size() * sizeof(Precision));
+
+        // the reply holds the weights after the update, it is delayed while this worker is too far ahead
+        if (!mReceive(socket, &version, sizeof(std::uint64_t)) || !mReceive(socket, buffer.data(), buffer.size() * sizeof(Precision)))
+        {
+            throw std::runtime_error("ParameterServer::mWork: The server closed the connection.");
+        }
+        std::uint64_t offset = 0;
+        for (const VariablePtr &pVar : learnableVariables)
+        {
+            std::copy_n(buffer.data() + offset, pVar->getData()->capacity(), pVar->getData()->data());
+            offset += pVar->getData()->capacity();
+            pVar->bumpVersion();
+        }
+    }
+}
+
+std::vector<std::vector<double>> ParameterServer::epoch(Dataset &dataset, const std::uint32_t batchSize, std::vector<VariablePtr> &graphInputs, const std::vector<VariablePtr> &learnableVariables, const std::vector<VariablePtr> &gradientVariables, const std::vector<VariablePtr> &lossVariables, OptimizerVariant &optimizer)
+{
+    if (dataset.isStreamed())
+    {
+        // the workers read every workers-th batch, and a forked worker has none of the reader threads of the stream
+        throw std::invalid_argument("ParameterServer::epoch: A streamed training set can not be trained by worker processes.");
+    }
+    const std::uint32_t batches = dataset.trainingBatchCount(batchSize);
+    if (batches == 0)
+    {
+        return {};
+    }
+    const std::vector<VariablePtr> order = GRAPH->getTopologicalOrder(graphInputs);
+    if (std::ranges::any_of(order, [](const VariablePtr &pVar) { return std::dynamic_pointer_cast<ShardedMatmul>(pVar->getOperation()) != nullptr; }))
+    {
+        // fork copies only the calling thread, the thread team of a sharded layer would wait for members that do not exist
+        throw std::invalid_argument("ParameterServer::epoch: Tensor parallel layers can not be trained by worker processes.");
+    }
+    const std::uint32_t workers = std::min(mWorkerCount, batches);
+    std::uint64_t parameters = 0;
+    for (const VariablePtr &pVar : learnableVariables)
+    {
+        parameters += pVar->getData()->capacity();
+    }
+
+    // fork the workers, each one inherits the graph, the dataset and its end of a socket pair
+    std::cout.flush();
+    std::vector<int> sockets;
+    std::vector<pid_t> processes;
+    for (std::uint32_t w = 0; w < workers; w++)
+    {
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0)
+        {
+            throw std::runtime_error("ParameterServer::epoch: The socket of a worker could not be created.");
+        }
+        const pid_t process = fork();
+        if (process == 0)
+        {
+            close(pair[0]);
+            for (const int socket : sockets)
+            {
+                close(socket);
+            }
+            int status = 0;
+            try
+            {
+                mWork(pair[1], w, batches, dataset, batchSize, graphInputs, learnableVariables, gradientVariables, lossVariables);
+            }
+            catch (const std::exception &exception)
+            {
+                std::cerr << exception.what() << std::endl;
+                status = 1;
+            }
+            _exit(status); // no destructors and no flushed copies of the buffers of the server
+        }
+        close(pair[1]);
+        if (process < 0)
+        {
+            close(pair[0]);
+            break;
+        }
+        sockets.push_back(pair[0]);
+        processes.push_back(process);
+    }
+
+    std::vector<std::vector<double>> losses(batches, std::vector<double>(lossVariables.size(), 0));
+    std::vector<std::uint32_t> clocks(sockets.size(), 0);     // the batches of every worker the server applied
+    std::vector<std::uint32_t> assigned(sockets.size(), 0);   // the batches of every worker
+    std::vector<bool> waiting(sockets.size(), false);         // the worker waits for the weights
+    for (std::uint32_t w = 0; w < sockets.size(); w++)
+    {
+        assigned[w] = (batches - w + workers - 1) / workers;
+    }
+    std::uint64_t version = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    bool failed = sockets.size() != workers;
+    std::exception_ptr pError = nullptr;
+    try
+    {
+        std::vector<Precision> buffer(parameters);
+        std::vector<std::shared_ptr<Tensor>> gradients;
+        for (const VariablePtr &pVar : learnableVariables)
+        {
+            gradients.push_back(std::make_shared<Tensor>(Tensor(pVar->getData()->shape(), 0)));
+        }
+        std::uint32_t received = 0;
+        while (!failed && received < batches)
+        {
+            std::vector<pollfd> ready;
+            for (std::uint32_t w = 0; w < sockets.size(); w++)
+            {
+                if (!waiting[w] && clocks[w] < assigned[w])
+                {
+                    ready.push_back({sockets[w], POLLIN, 0});
+                }
+            }
+            if (poll(ready.data(), ready.size(), -1) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::runtime_error("ParameterServer::epoch: Waiting for the workers failed.");
+            }
+
+            for (const pollfd &descriptor : ready)
+            {
+                if (descriptor.revents == 0)
+                {
+                    continue;
+                }
+                const std::uint32_t w = std::ranges::find(sockets, descriptor.fd) - sockets.begin();
+                Push push;
+                if (!mReceive(descriptor.fd, &push, sizeof(Push)) || !mReceive(descriptor.fd, buffer.data(), parameters * sizeof(Precision)))
+                {
+                    failed = true; // the worker died, its error is on stderr
+                    break;
+                }
+                std::uint64_t offset = 0;
+                for (std::shared_ptr<Tensor> &gradient : gradients)
+                {
+                    std::copy_n(buffer.data() + offset, gradient->capacity(), gradient->data());
+                    offset += gradient->capacity();
+                }
+                GRAPH->setGradients(learnableVariables, gradients);
+                std::visit([&](auto &&arg) { arg.update(learnableVariables); }, optimizer);
+
+                mMissedUpdates += static_cast<double>(version - push.version);
+                version++;
+                losses[push.batch] = {push.loss, push.surrogateLoss};
+                clocks[w]++;
+                waiting[w] = true;
+                received++;
+                mBytes += sizeof(Push) + parameters * sizeof(Precision);
+            }
+
+            // answer every waiting worker that is at most mStaleness batches ahead of the slowest unfinished worker
+            std::uint32_t slowest = std::numeric_limits<std::uint32_t>::max();
+            for (std::uint32_t w = 0; w < sockets.size(); w++)
+            {
+                if (clocks[w] < assigned[w])
+                {
+                    slowest = std::min(slowest, clocks[w]);
+                }
+            }
+            bool collected = false;
+            for (std::uint32_t w = 0; w < sockets.size(); w++)
+            {
+                if (waiting[w] && (clocks[w] == assigned[w] || clocks[w] <= slowest + mStaleness))
+                {
+                    if (!collected)
+                    {
+                        std::uint64_t offset = 0;
+                        for (const VariablePtr &pVar : learnableVariables)
+                        {
+                            std::copy_n(pVar->getData()->data(), pVar->getData()->capacity(), buffer.data() + offset);
+                            offset += pVar->getData()->capacity();
+                        }
+                        collected = true;
+                    }
+                    mSend(sockets[w], &version, sizeof(std::uint64_t));
+                    mSend(sockets[w], buffer.data(), parameters * sizeof(Precision));
+                    mBytes += sizeof(std::uint64_t) + parameters * sizeof(Precision);
+                    waiting[w] = false;
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        pError = std::current_exception();
+    }
+
+    for (const int socket : sockets) // a worker that still waits for the server sees the closed socket and stops
+    {
+        close(socket);
+    }
+    for (const pid_t process : processes)
+    {
+        int status = 0;
+        waitpid(process, &status, 0);
+        failed = failed || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+    if (pError != nullptr)
+    {
+        std::rethrow_exception(pError);
+    }
+    if (failed)
+    {
+        throw std::runtime_error("ParameterServer::epoch: A worker process failed.");
+    }
+    mWallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    mUpdates += batches;
+    mExamples += static_cast<std::uint64_t>(batches) * batchSize;
+    return losses;
+}
+
+#else
+
+std::vector<std::vector<double>> ParameterServer::epoch(Dataset &, std::uint32_t, std::vector<VariablePtr> &, const std::vector<VariablePtr> &, const std::vector<VariablePtr> &, const std::vector<VariablePtr> &, OptimizerVariant &)
+{
+    throw std::invalid_argument("ParameterServer::epoch: Worker processes require a POSIX system.");
+}
+
+#endif
+
+std::uint32_t ParameterServer::workerCount() const
+{
+    return mWorkerCount;
+}
+
+std::uint32_t ParameterServer::staleness() const
+{
+    return mStaleness;
+}
+
+double ParameterServer::examplesPerSecond() const
+{
+    return mWallSeconds == 0 ? 0 : static_cast<double>(mExamples) / mWallSeconds;
+}
+
+double ParameterServer::meanStaleness() const
+{
+    return mUpdates == 0 ? 0 : mMissedUpdates / static_cast<double>(mUpdates);
+}
+
+std::uint64_t ParameterServer::bytesTransferred() const
+{
+    return mBytes;
+}
+
+void ParameterServer::resetStatistics()
+{
+    mWallSeconds = 0;
+    mMissedUpdates = 0;
+    mUpdates = 0;
+    mExamples = 0;
+    mBytes = 0;
+}
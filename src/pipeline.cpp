@@ -0,0 +1,429 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "pipeline.hpp"
+
+void Pipeline::Mailbox::put(const std::uint32_t microBatch, const std::shared_ptr<Tensor> &tensor)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mItems[microBatch] = tensor;
+    }
+    mReady.notify_all();
+}
+
+std::shared_ptr<Tensor> Pipeline::Mailbox::take(const std::uint32_t microBatch)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mReady.wait(lock, [&]() { return mClosed || mItems[microBatch] != nullptr; });
+    if (mClosed)
+    {
+        return nullptr;
+    }
+    std::shared_ptr<Tensor> tensor = nullptr;
+    tensor.swap(mItems[microBatch]);
+    return tensor;
+}
+
+void Pipeline::Mailbox::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClosed = true;
+    }
+    mReady.notify_all();
+}
+
+Pipeline::Pipeline(const std::uint32_t stages, const std::uint32_t microBatches) :
+mStageCount(stages),
+mMicroBatches(microBatches),
+mCoresPerStage(ThreadTeam::coreShare(stages)),
+mTeam(stages, mCoresPerStage)
+{
+    if (microBatches == 0)
+    {
+        throw std::invalid_argument("Pipeline::Pipeline: A batch needs at least one micro-batch.");
+    }
+    for (std::uint32_t s = 0; s < stages; s++)
+    {
+        mPlaceholders.push_back(GRAPH->addVariable(std::make_shared<Variable>(Variable(nullptr))));
+    }
+    mpLabelPlaceholder = GRAPH->addVariable(std::make_shared<Variable>(Variable(nullptr)));
+}
+
+std::vector<Pipeline::Stage> Pipeline::mSplit(const std::vector<std::shared_ptr<Module>> &modules, const VariablePtr &pData) const
+{
+    std::vector<std::shared_ptr<Module>> layers;
+    std::vector<std::shared_ptr<Module>> losses;
+    for (const std::shared_ptr<Module> &module : modules)
+    {
+        (std::dynamic_pointer_cast<Loss>(module) != nullptr ? losses : layers).push_back(module);
+    }
+    if (layers.size() < mStageCount)
+    {
+        throw std::invalid_argument("Pipeline::mSplit: The model has fewer layers than the pipeline has stages.");
+    }
+    for (size_t i = 0; i < layers.size(); i++) // every layer has to read exactly the output of the previous one
+    {
+        const std::vector<VariablePtr> &inputs = layers[i]->getInputs()[0]->getInputs();
+        const VariablePtr pExpected = i == 0 ? pData : layers[i - 1]->getOutputs()[0];
+        if (inputs.size() != 1 || inputs[0] != pExpected)
+        {
+            throw std::invalid_argument("Pipeline::mSplit: Pipeline parallelism needs a sequential model.");
+        }
+    }
+
+    // the work of a layer is proportional to its number of parameters, the stages get contiguous groups with the smallest maximum work
+    const size_t n = layers.size();
+    std::vector<double> prefix(n + 1, 0);
+    for (size_t i = 0; i < n; i++)
+    {
+        double parameters = 1;
+        for (const VariablePtr &pLearnable : layers[i]->getLearnableVariables())
+        {
+            parameters += pLearnable->getData() == nullptr ? 0 : pLearnable->getData()->capacity();
+        }
+        prefix[i + 1] = prefix[i] + parameters;
+    }
+    // cost[s][i]: the maximum work when the first i layers form s + 1 stages, cut[s][i]: where the last of these stages begins
+    std::vector<std::vector<double>> cost(mStageCount, std::vector<double>(n + 1, std::numeric_limits<double>::max()));
+    std::vector<std::vector<size_t>> cut(mStageCount, std::vector<size_t>(n + 1, 0));
+    for (size_t i = 1; i <= n; i++)
+    {
+        cost[0][i] = prefix[i];
+    }
+    for (std::uint32_t s = 1; s < mStageCount; s++)
+    {
+        for (size_t i = s + 1; i <= n; i++)
+        {
+            for (size_t j = s; j < i; j++)
+            {
+                const double work = std::max(cost[s - 1][j], prefix[i] - prefix[j]);
+                if (work < cost[s][i])
+                {
+                    cost[s][i] = work;
+                    cut[s][i] = j;
+                }
+            }
+        }
+    }
+    std::vector<size_t> begins(mStageCount + 1, n);
+    for (std::uint32_t s = mStageCount - 1; s > 0; s--)
+    {
+        begins[s] = cut[s][begins[s + 1]];
+    }
+    begins[0] = 0;
+
+    std::vector<Stage> stages(mStageCount);
+    for (std::uint32_t s = 0; s < mStageCount; s++)
+    {
+        Stage &stage = stages[s];
+        stage.modules.assign(layers.begin() + static_cast<std::ptrdiff_t>(begins[s]), layers.begin() + static_cast<std::ptrdiff_t>(begins[s + 1]));
+        stage.pSource = s == 0 ? pData : stages[s - 1].pOutput;
+        stage.pOutput = stage.modules.back()->getOutputs()[0];
+    }
+    stages.back().modules.insert(stages.back().modules.end(), losses.begin(), losses.end());
+    stages.back().pOutput = nullptr;
+    return stages;
+}
+
+void Pipeline::mRedirect(const VariablePtr &pFrom, const VariablePtr &pTo)
+{
+    for (const VariablePtr &pConsumer : pFrom->getConsumers())
+    {
+        std::ranges::replace(pConsumer->getInputs(), pFrom, pTo);
+    }
+    pTo->getConsumers() = std::move(pFrom->getConsumers());
+    pFrom->getConsumers().clear();
+}
+
+std::shared_ptr<Tensor> Pipeline::mSlice(Tensor &batch, const std::uint32_t microBatches, const std::uint32_t microBatch)
+{
+    std::vector<size_t> shape = batch.shape();
+    shape[0] /= microBatches;
+    std::shared_ptr<Tensor> part = std::make_shared<Tensor>(Tensor(shape));
+    std::copy_n(batch.data() + static_cast<std::uint64_t>(microBatch) * part->capacity(), part->capacity(), part->data());
+    return part;
+}
+
+void Pipeline::step(const std::vector<std::shared_ptr<Module>> &modules, std::vector<VariablePtr> &graphInputs, const std::vector<VariablePtr> &learnableVariables, const std::vector<VariablePtr> &gradientVariables, const std::vector<VariablePtr> &lossVariables, const double leafInitValue)
+{
+    const VariablePtr pData = graphInputs[0];
+    const VariablePtr pLabels = graphInputs[1];
+    if (pData->getData()->shape(0) % mMicroBatches != 0)
+    {
+        throw std::invalid_argument("Pipeline::step: The batch size must be a multiple of the number of micro-batches.");
+    }
+    std::vector<Stage> stages = mSplit(modules, pData);
+    const std::uint32_t stageCount = mStageCount;
+    const std::uint32_t microBatches = mMicroBatches;
+
+    // cut the graph at the stage boundaries, then every stage only reaches its own variables
+    for (std::uint32_t s = 0; s < stageCount; s++)
+    {
+        mRedirect(stages[s].pSource, mPlaceholders[s]);
+    }
+    mRedirect(pLabels, mpLabelPlaceholder);
+    auto reconnect = [&]() {
+        mRedirect(mpLabelPlaceholder, pLabels);
+        for (std::uint32_t s = stageCount; s > 0; s--)
+        {
+            mRedirect(mPlaceholders[s - 1], stages[s - 1].pSource);
+        }
+    };
+
+    std::vector<std::vector<std::shared_ptr<Tensor>>> stageGradients(stageCount);
+    std::vector<std::vector<double>> losses(microBatches, std::vector<double>(lossVariables.size(), 0));
+    std::vector<double> busySeconds(stageCount, 0);
+    try
+    {
+        for (std::uint32_t s = 0; s < stageCount; s++)
+        {
+            Stage &stage = stages[s];
+            std::vector<VariablePtr> roots = {mPlaceholders[s]};
+            if (s + 1 == stageCount)
+            {
+                roots.push_back(mpLabelPlaceholder);
+            }
+            for (const std::shared_ptr<Module> &module : stage.modules)
+            {
+                const std::vector<VariablePtr> learnables = module->getLearnableVariables();
+                stage.learnables.insert(stage.learnables.end(), learnables.begin(), learnables.end());
+            }
+            roots.insert(roots.end(), stage.learnables.begin(), stage.learnables.end());
+
+            stage.stashed = {roots.begin(), roots.end() - static_cast<std::ptrdiff_t>(stage.learnables.size())};
+            for (const VariablePtr &pVar : GRAPH->getTopologicalOrder(roots))
+            {
+                if (pVar->getOperation() == nullptr)
+                {
+                    continue;
+                }
+                if (const std::shared_ptr<Dropout> pDropout = std::dynamic_pointer_cast<Dropout>(pVar->getOperation()); pDropout != nullptr && pDropout->getDropoutRate() < 1)
+                {
+                    throw std::invalid_argument("Pipeline::step: Dropout is not supported in pipeline parallel training.");
+                }
+                stage.variables.push_back(pVar);
+                stage.stashed.push_back(pVar);
+                if (std::ranges::find(gradientVariables, pVar) != gradientVariables.end())
+                {
+                    stage.leaves.push_back(pVar);
+                }
+            }
+        }
+
+        std::vector<std::shared_ptr<Tensor>> dataSlices, labelSlices;
+        for (std::uint32_t i = 0; i < microBatches; i++)
+        {
+            dataSlices.push_back(mSlice(*pData->getData(), microBatches, i));
+            labelSlices.push_back(mSlice(*pLabels->getData(), microBatches, i));
+        }
+        std::vector<std::unique_ptr<Mailbox>> activations, gradients; // mailbox s connects stage s and s + 1
+        for (std::uint32_t s = 0; s + 1 < stageCount; s++)
+        {
+            activations.push_back(std::make_unique<Mailbox>(microBatches));
+            gradients.push_back(std::make_unique<Mailbox>(microBatches));
+        }
+
+        std::mutex errorMutex;
+        std::exception_ptr pError = nullptr;
+        const auto start = std::chrono::steady_clock::now();
+        mTeam.run([&](const std::uint32_t s) {
+            Parallel::setLocalThreadCount(mCoresPerStage); // the kernels of all stages together use every core once
+            try
+            {
+                Stage &stage = stages[s];
+                const bool last = s + 1 == stageCount;
+                std::vector<VariablePtr> targets = stage.learnables;
+                if (s > 0)
+                {
+                    targets.push_back(mPlaceholders[s]);
+                }
+                std::vector<std::vector<std::shared_ptr<Tensor>>> stash(microBatches);
+                std::vector<std::shared_ptr<Tensor>> &accumulated = stageGradients[s];
+                accumulated.assign(stage.learnables.size(), nullptr);
+
+                auto forward = [&](const std::uint32_t i) {
+                    const std::shared_ptr<Tensor> pInput = s == 0 ? dataSlices[i] : activations[s - 1]->take(i);
+                    if (pInput == nullptr)
+                    {
+                        return false;
+                    }
+                    const auto begin = std::chrono::steady_clock::now();
+                    mPlaceholders[s]->setData(pInput);
+                    if (last)
+                    {
+                        mpLabelPlaceholder->setData(labelSlices[i]);
+                    }
+                    for (const VariablePtr &pVar : stage.variables) // fresh tensors, the data of earlier micro-batches is still needed
+                    {
+                        pVar->getData() = nullptr;
+                    }
+                    Graph::execute(stage.variables);
+                    for (const VariablePtr &pVar : stage.stashed)
+                    {
+                        stash[i].push_back(pVar->getData());
+                    }
+                    if (last)
+                    {
+                        for (size_t k = 0; k < lossVariables.size(); k++)
+                        {
+                            losses[i][k] = lossVariables[k]->getData()->at(0);
+                        }
+                    }
+                    else
+                    {
+                        activations[s]->put(i, stage.pOutput->getData());
+                    }
+                    busySeconds[s] += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+                    return true;
+                };
+
+                auto backward = [&](const std::uint32_t i) {
+                    Graph::GradTable seeds;
+                    if (!last)
+                    {
+                        seeds[stage.pOutput] = gradients[s]->take(i);
+                        if (seeds[stage.pOutput] == nullptr)
+                        {
+                            return false;
+                        }
+                    }
+                    const auto begin = std::chrono::steady_clock::now();
+                    for (size_t j = 0; j < stage.stashed.size(); j++)
+                    {
+                        stage.stashed[j]->setData(stash[i][j]);
+                    }
+                    stash[i].clear();
+                    Graph::seedLeaves(seeds, stage.leaves, lossVariables, leafInitValue, microBatches);
+
+                    std::vector<std::shared_ptr<Tensor>> parts = Graph::computeGradients(targets, seeds);
+                    for (size_t j = 0; j < accumulated.size(); j++)
+                    {
+                        if (accumulated[j] == nullptr)
+                        {
+                            accumulated[j] = std::make_shared<Tensor>(*parts[j]);
+                            continue;
+                        }
+                        Precision *pSum = accumulated[j]->data();
+                        const Precision *pPart = parts[j]->data();
+                        for (std::uint32_t k = 0; k < accumulated[j]->capacity(); k++)
+                        {
+                            pSum[k] += pPart[k];
+                        }
+                    }
+                    busySeconds[s] += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+                    if (s > 0)
+                    {
+                        gradients[s - 1]->put(i, parts.back());
+                    }
+                    return true;
+                };
+
+                // 1F1B: warm up with forward passes, alternate, then drain the remaining backward passes
+                const std::uint32_t warmup = std::min(stageCount - s - 1, microBatches);
+                std::uint32_t forwards = 0;
+                std::uint32_t backwards = 0;
+                for (; forwards < warmup; forwards++)
+                {
+                    if (!forward(forwards))
+                    {
+                        return;
+                    }
+                }
+                for (; forwards < microBatches; forwards++, backwards++)
+                {
+                    if (!forward(forwards) || !backward(backwards))
+                    {
+                        return;
+                    }
+                }
+                for (; backwards < microBatches; backwards++)
+                {
+                    if (!backward(backwards))
+                    {
+                        return;
+                    }
+                }
+            }
+            catch (...)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (pError == nullptr)
+                    {
+                        pError = std::current_exception();
+                    }
+                }
+                for (size_t m = 0; m < activations.size(); m++) // release the other stages
+                {
+                    activations[m]->close();
+                    gradients[m]->close();
+                }
+            }
+        });
+        mWallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        mBusySeconds += std::accumulate(busySeconds.begin(), busySeconds.end(), 0.0);
+        if (pError != nullptr)
+        {
+            std::rethrow_exception(pError);
+        }
+    }
+    catch (...)
+    {
+        reconnect();
+        throw;
+    }
+    reconnect();
+
+    std::vector<std::shared_ptr<Tensor>> batchGradients;
+    for (const VariablePtr &pLearnable : learnableVariables)
+    {
+        for (std::uint32_t s = 0; s < stageCount; s++)
+        {
+            if (const auto it = std::ranges::find(stages[s].learnables, pLearnable); it != stages[s].learnables.end())
+            {
+                batchGradients.push_back(stageGradients[s][it - stages[s].learnables.begin()]);
+                break;
+            }
+        }
+    }
+    GRAPH->setGradients(learnableVariables, batchGradients);
+
+    for (size_t k = 0; k < lossVariables.size(); k++)
+    {
+        double sum = 0;
+        for (std::uint32_t i = 0; i < microBatches; i++)
+        {
+            sum += losses[i][k];
+        }
+        lossVariables[k]->setData(std::make_shared<Tensor>(Tensor({1}, sum / microBatches)));
+    }
+}
+
+std::uint32_t Pipeline::stageCount() const
+{
+    return mStageCount;
+}
+
+std::uint32_t Pipeline::microBatchCount() const
+{
+    return mMicroBatches;
+}
+
+double Pipeline::bubbleFraction() const
+{
+    return mWallSeconds == 0 ? 0 : bubbleSeconds() / (mStageCount * mWallSeconds);
+}
+
+double Pipeline::bubbleSeconds() const
+{
+    return std::max(0.0, mStageCount * mWallSeconds - mBusySeconds);
+}
+
+void Pipeline::resetStatistics()
+{
+    mBusySeconds = 0;
+    mWallSeconds = 0;
+}
@@ -3,11 +3,144 @@
 //
 
 #include "preprocessing/preprocessing.hpp"
+#include "parallel.hpp"
+
+namespace
+{
+    /**
+     * @brief collect the statistics of rows [0, rows) in blocks of a fixed number of rows and merge them in order
+     */
+    Preprocessing::Statistics collect(const std::uint64_t rows, const std::uint64_t width, const std::function<void(std::uint64_t, Precision *)> &copyRow)
+    {
+        const std::uint64_t blocks = std::clamp<std::uint64_t>(rows / 1024, 1, 256);
+        std::vector<Preprocessing::Statistics> partial(blocks, Preprocessing::Statistics(width));
+        Parallel::forEach(blocks, rows * width, [&](const std::uint64_t block) {
+            std::vector<Precision> row(width);
+            for (std::uint64_t r = rows * block / blocks; r < rows * (block + 1) / blocks; r++)
+            {
+                copyRow(r, row.data());
+                partial[block].add(row.data());
+            }
+        });
+        for (std::uint64_t block = 1; block < blocks; block++)
+        {
+            partial[0].merge(partial[block]);
+        }
+        return std::move(partial[0]);
+    }
+}
+
+Preprocessing::Statistics::Statistics(const std::uint64_t width) :
+minimum(width, std::numeric_limits<double>::infinity()),
+maximum(width, -std::numeric_limits<double>::infinity()),
+mean(width, 0),
+m2(width, 0)
+{
+}
+
+void Preprocessing::Statistics::add(const Precision *pValues)
+{
+    count++;
+    const double weight = 1.0 / static_cast<double>(count);
+    for (size_t j = 0; j < mean.size(); j++)
+    {
+        const double value = pValues[j];
+        minimum[j] = std::min(minimum[j], value);
+        maximum[j] = std::max(maximum[j], value);
+        const double delta = value - mean[j];
+        mean[j] += delta * weight;
+        m2[j] += delta * (value - mean[j]);
+    }
+}
+
+void Preprocessing::Statistics::merge(const Statistics &other)
+{
+    if (other.count == 0)
+    {
+        return;
+    }
+    if (count == 0)
+    {
+        *this = other;
+        return;
+    }
+    if (other.mean.size() != mean.size())
+    {
+        throw std::invalid_argument("Preprocessing::Statistics::merge: The statistics have different widths.");
+    }
+    const double total = static_cast<double>(count + other.count);
+    const double share = static_cast<double>(other.count) / total;
+    for (size_t j = 0; j < mean.size(); j++) // Chan et al., the parallel form of Welford's algorithm
+    {
+        minimum[j] = std::min(minimum[j], other.minimum[j]);
+        maximum[j] = std::max(maximum[j], other.maximum[j]);
+        const double delta = other.mean[j] - mean[j];
+        mean[j] += delta * share;
+        m2[j] += other.m2[j] + delta * delta * static_cast<double>(count) * share;
+    }
+    count += other.count;
+}
+
+std::vector<double> Preprocessing::Statistics::standardDeviation() const
+{
+    std::vector<double> deviation(m2.size(), 0);
+    if (count > 0)
+    {
+        std::ranges::transform(m2, deviation.begin(), [this](const double sum) { return std::sqrt(sum / static_cast<double>(count)); });
+    }
+    return deviation;
+}
+
+double Preprocessing::Statistics::smallest() const
+{
+    return minimum.empty() ? std::numeric_limits<double>::infinity() : *std::ranges::min_element(minimum);
+}
+
+double Preprocessing::Statistics::largest() const
+{
+    return maximum.empty() ? -std::numeric_limits<double>::infinity() : *std::ranges::max_element(maximum);
+}
+
+Preprocessing::Statistics Preprocessing::statistics(const SampleStorage &samples)
+{
+    return collect(samples.size(), samples.width(), [&](const std::uint64_t r, Precision *pRow) { samples.copyRow(r, pRow, false); });
+}
+
+Preprocessing::Statistics Preprocessing::statistics(const dataType &data)
+{
+    const std::uint64_t width = data.empty() ? 0 : data[0].size();
+    for (const auto & row : data)
+    {
+        if (row.size() != width)
+        {
+            throw std::invalid_argument("Preprocessing::statistics: The samples have different widths.");
+        }
+    }
+    return collect(data.size(), width, [&](const std::uint64_t r, Precision *pRow) { std::ranges::copy(data[r], pRow); });
+}
+
+void Preprocessing::transform(dataType &data, const std::vector<Precision> &scale, const std::vector<Precision> &offset)
+{
+    const std::uint64_t width = data.empty() ? 0 : data[0].size();
+    auto valid = [width](const std::vector<Precision> &values) { return values.size() == 1 || values.size() == width; };
+    if (!valid(scale) || !valid(offset))
+    {
+        throw std::invalid_argument("Preprocessing::transform: The transformation needs one value or one value per feature.");
+    }
+    Parallel::forRange(data.size(), data.size() * width, [&](const std::uint64_t begin, const std::uint64_t end) {
+        for (std::uint64_t i = begin; i < end; i++)
+        {
+            for (size_t j = 0; j < data[i].size(); j++)
+            {
+                data[i][j] = data[i][j] * scale[scale.size() == 1 ? 0 : j] + offset[offset.size() == 1 ? 0 : j];
+            }
+        }
+    });
+}
 
 void Preprocessing::addNoise(dataType &data, const double &mean, const double &stddev)
 {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen = Random::generator(Random::Stream::NOISE);
     std::normal_distribution<double> dist(mean, stddev);
 
     for (auto & i : data)
@@ -21,29 +154,19 @@ void Preprocessing::addNoise(dataType &data, const double &mean, const double &s
 
 Preprocessing::dataType Preprocessing::normalize(dataType const & input)
 {
-    dataType normalizedData(input.size(), std::vector<Precision>(input[0].size()));
-
-    Precision max = std::numeric_limits<double>::min();
-
-    for (const auto & i : input)
-    {
-        max=std::max(*std::ranges::max_element(i),max);
-    }
-
-    for (std::uint32_t i = 0; i < input.size(); i++)
+    const Precision max = static_cast<Precision>(statistics(input).largest());
+    if (!(max > 0))
     {
-        std::ranges::transform(input[i], normalizedData[i].begin(), [max](Precision const & value) { return value / max; });
+        throw std::invalid_argument("Preprocessing::normalize: The largest value must be positive.");
     }
 
+    dataType normalizedData = input;
+    transform(normalizedData, {1 / max}, {0});
     return normalizedData;
 }
 
 void Preprocessing::splitData(dataType const & input, dataType const & target, double const & ratio, dataType & trainInput, dataType & validationInput, dataType & trainTarget, dataType & validationTarget)
 {
-    if (ratio < 0.0 || ratio > 1.0)
-    {
-        throw std::invalid_argument("The ratio must be between 0 and 1.");
-    }
     if (input.size() != target.size())
     {
         throw std::invalid_argument("The input and target sizes must be the same.");
@@ -54,21 +177,44 @@ void Preprocessing::splitData(dataType const & input, dataType const & target, d
     trainTarget = {};
     validationTarget = {};
 
-    std::uint32_t split_index = std::round(input.size() * ratio);
+    std::vector<std::uint32_t> trainIndices;
+    std::vector<std::uint32_t> validationIndices;
+    splitIndices(input.size(), ratio, trainIndices, validationIndices);
 
-    std::vector<std::uint32_t> indices(input.size());
-    std::iota(indices.begin(), indices.end(), 0);
-    std::ranges::shuffle(indices, std::mt19937{std::random_device{}()});
+    trainInput.reserve(trainIndices.size());
+    trainTarget.reserve(trainIndices.size());
+    validationInput.reserve(validationIndices.size());
+    validationTarget.reserve(validationIndices.size());
+    for (const std::uint32_t index : trainIndices)
+    {
+        trainInput.push_back(input[index]);
+        trainTarget.push_back(target[index]);
+    }
 
-    for (std::uint32_t i = 0; i < split_index; i++)
+    for (const std::uint32_t index : validationIndices)
     {
-        trainInput.push_back(input[indices[i]]);
-        trainTarget.push_back(target[indices[i]]);
+        validationInput.push_back(input[index]);
+        validationTarget.push_back(target[index]);
     }
+}
 
-    for (std::uint32_t i = split_index; i < input.size(); i++)
+void Preprocessing::splitIndices(const std::uint32_t size, const double ratio, std::vector<std::uint32_t> & trainIndices, std::vector<std::uint32_t> & validationIndices)
+{
+    splitIndices(size, ratio, trainIndices, validationIndices, Random::generator(Random::Stream::SPLIT));
+}
+
+void Preprocessing::splitIndices(const std::uint32_t size, const double ratio, std::vector<std::uint32_t> & trainIndices, std::vector<std::uint32_t> & validationIndices, std::mt19937 generator)
+{
+    if (ratio < 0.0 || ratio > 1.0)
     {
-        validationInput.push_back(input[indices[i]]);
-        validationTarget.push_back(target[indices[i]]);
+        throw std::invalid_argument("The ratio must be between 0 and 1.");
     }
+    const std::uint32_t split_index = std::round(size * ratio);
+
+    std::vector<std::uint32_t> indices(size);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::ranges::shuffle(indices, generator);
+
+    trainIndices.assign(indices.begin(), indices.begin() + split_index);
+    validationIndices.assign(indices.begin() + split_index, indices.end());
 }
\ No newline at end of file
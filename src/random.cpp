@@ -0,0 +1,42 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "random.hpp"
+
+bool Random::msDeterministic = false;
+std::uint64_t Random::msSeed = 0;
+std::array<std::uint64_t, static_cast<size_t>(Random::Stream::COUNT)> Random::msGenerators = {};
+std::mutex Random::msMutex;
+
+void Random::setSeed(const std::uint64_t seed)
+{
+    std::lock_guard<std::mutex> lock(msMutex);
+    msSeed = seed;
+    msDeterministic = true;
+    msGenerators.fill(0);
+}
+
+void Random::setDeterministic(const bool deterministic)
+{
+    std::lock_guard<std::mutex> lock(msMutex);
+    msDeterministic = deterministic;
+    msGenerators.fill(0);
+}
+
+bool Random::isDeterministic()
+{
+    return msDeterministic;
+}
+
+std::mt19937 Random::generator(const Stream stream)
+{
+    std::lock_guard<std::mutex> lock(msMutex);
+    if (!msDeterministic)
+    {
+        return std::mt19937(std::random_device()());
+    }
+    const std::uint64_t index = msGenerators[static_cast<size_t>(stream)]++;
+    std::seed_seq sequence = {static_cast<std::uint32_t>(msSeed), static_cast<std::uint32_t>(msSeed >> 32), static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32)};
+    return std::mt19937(sequence);
+}
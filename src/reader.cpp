@@ -3,90 +3,306 @@
 //
 
 #include "../include/reader.hpp"
+#include "parallel.hpp"
+
+#include <charconv>
+#include <cstring>
 
 Reader::data_type Reader::read_idx(const std::string& path)
 {
-    std::ifstream file(std::filesystem::path(path), std::ios::binary);
+    const SampleStorage samples = read_idx_samples(path);
 
-    if (!file.is_open())
-        throw std::invalid_argument("IDX_READER::read_idx: Could not open file");
+    Reader::data_type tensor(samples.size(), std::vector<Precision>(samples.width()));
+    for (size_t i = 0; i < tensor.size(); i++)
+    {
+        samples.copyRow(i, tensor[i].data());
+    }
+    return tensor;
+}
 
+Reader::idx_header Reader::read_idx_header(const std::byte *pFile, const size_t length)
+{
     // to understand the IDX file format, see: http://yann.lecun.com/exdb/mnist/
+    // the magic number is two zero bytes, the type of the values and the number of dimensions, all integers are big-endian
 
+    if (length < 4 || pFile[0] != std::byte{0} || pFile[1] != std::byte{0} || pFile[3] == std::byte{0})
+    {
+        throw std::invalid_argument("IDX_READER::read_idx_header: Unknown magic number");
+    }
 
-    auto file_iterator = std::istreambuf_iterator<char>(file);
-    auto file_end = std::istreambuf_iterator<char>{};
+    idx_header header;
+    switch (std::to_integer<std::uint8_t>(pFile[2]))
+    {
+        case 0x08: header.type = SampleStorage::Type::UINT8; break;
+        case 0x09: header.type = SampleStorage::Type::INT8; break;
+        case 0x0B: header.type = SampleStorage::Type::INT16; break;
+        case 0x0C: header.type = SampleStorage::Type::INT32; break;
+        case 0x0D: header.type = SampleStorage::Type::FLOAT32; break;
+        case 0x0E: header.type = SampleStorage::Type::FLOAT64; break;
+        default: throw std::invalid_argument("IDX_READER::read_idx_header: Unknown magic number");
+    }
+
+    const size_t dimensions = std::to_integer<size_t>(pFile[3]);
+    header.offset = 4 + 4 * dimensions;
+    if (length < header.offset)
+    {
+        throw std::invalid_argument("IDX_READER::read_idx_header: Unexpected end of file");
+    }
+    header.shape.resize(dimensions);
+    for (size_t i = 0; i < dimensions; i++)
+    {
+        const std::byte *pDimension = pFile + 4 + 4 * i;
+        header.shape[i] = std::to_integer<size_t>(pDimension[0]) << 24 | std::to_integer<size_t>(pDimension[1]) << 16 | std::to_integer<size_t>(pDimension[2]) << 8 | std::to_integer<size_t>(pDimension[3]);
+    }
+    header.width = std::accumulate(header.shape.begin() + 1, header.shape.end(), size_t(1), std::multiplies<>());
+    return header;
+}
 
-    std::array<std::byte, 4> magic{};
+SampleStorage Reader::read_idx_samples(const std::string& path)
+{
+    const std::shared_ptr<const MappedFile> file = std::make_shared<const MappedFile>(path);
+    const idx_header header = read_idx_header(file->data(), file->size());
 
-    for (std::uint32_t i = 0; i < 4; i++)
+    const size_t count = header.shape[0] * header.width;
+    if (file->size() - header.offset < count * SampleStorage::elementSize(header.type))
     {
-        magic[i] = static_cast<std::byte>(*file_iterator++);
+        throw std::invalid_argument("IDX_READER::read_idx_samples: Unexpected end of file");
     }
+    return {file, file->data() + header.offset, header.type, true, count, header.width}; // the values stay in the mapping
+}
+
+void Reader::read_cifar(const std::vector<std::string>& paths, SampleStorage& images, SampleStorage& labels, const bool cifar100, const image_layout layout, const bool fineLabels)
+{
+    // CIFAR format: https://www.cs.toronto.edu/~kriz/cifar.html
 
-    Reader::data_type tensor;
+    constexpr size_t pixels = 32 * 32;
+    constexpr size_t imageBytes = 3 * pixels;
+    const size_t labelBytes = cifar100 ? 2 : 1;
+    const size_t recordBytes = labelBytes + imageBytes;
+    const size_t labelPosition = cifar100 && fineLabels ? 1 : 0;
 
-    if ( magic[2] == static_cast<std::byte>(0x08) )
+    std::vector<std::shared_ptr<const MappedFile>> files;
+    size_t records = 0;
+    for (const std::string& path : paths)
     {
-        auto dimensions = static_cast<size_t>(magic[3]);
-        std::vector<size_t> shape(dimensions);
-        for (std::uint32_t i = 0; i < dimensions; i++)
+        files.push_back(std::make_shared<const MappedFile>(path));
+        if (files.back()->size() == 0 || files.back()->size() % recordBytes != 0)
         {
-            std::array<std::byte, 4> dimension{};
-            for (std::uint32_t j = 0; j < 4; j++)
+            throw std::invalid_argument("CIFAR_READER::read_cifar: " + path + " is not a CIFAR batch file");
+        }
+        records += files.back()->size() / recordBytes;
+    }
+
+    std::vector<std::uint8_t> imageValues(records * imageBytes);
+    std::vector<std::uint8_t> labelValues(records);
+    size_t first = 0;
+    for (const std::shared_ptr<const MappedFile>& file : files)
+    {
+        const size_t count = file->size() / recordBytes;
+        const auto *pFile = reinterpret_cast<const std::uint8_t*>(file->data());
+        Parallel::forRange(count, count * imageBytes, [&](const std::uint64_t begin, const std::uint64_t end) {
+            for (std::uint64_t r = begin; r < end; r++)
             {
-                dimension[j] = static_cast<std::byte>(*file_iterator++);
+                const std::uint8_t *pRecord = pFile + r * recordBytes;
+                const std::uint8_t *pPlanes = pRecord + labelBytes;
+                std::uint8_t *pImage = imageValues.data() + (first + r) * imageBytes;
+                labelValues[first + r] = pRecord[labelPosition];
+                if (layout == image_layout::NCHW)
+                {
+                    std::memcpy(pImage, pPlanes, imageBytes);
+                    continue;
+                }
+                for (size_t p = 0; p < pixels; p++) // interleave the planes, a loop the compiler vectorizes with byte shuffles
+                {
+                    pImage[3 * p] = pPlanes[p];
+                    pImage[3 * p + 1] = pPlanes[pixels + p];
+                    pImage[3 * p + 2] = pPlanes[2 * pixels + p];
+                }
             }
-            shape[i] = static_cast<size_t>(dimension[0]) << 24 | static_cast<size_t>(dimension[1]) << 16 | static_cast<size_t>(dimension[2]) << 8 | static_cast<size_t>(dimension[3]);
-        }
+        });
+        first += count;
+    }
+    images = SampleStorage(std::move(imageValues), imageBytes);
+    labels = SampleStorage(std::move(labelValues), 1);
+}
+
+void Reader::read_csv(const std::string& path, SampleStorage& samples, SampleStorage& labels, const std::vector<size_t>& labelColumns, const std::vector<size_t>& featureColumns, const char delimiter, const bool header)
+{
+    const MappedFile file(path);
+    const char *pBegin = reinterpret_cast<const char*>(file.data());
+    const char *pEnd = pBegin + file.size();
 
-        tensor = Reader::data_type(shape[0], std::vector<Precision>(std::accumulate(shape.begin() + 1, shape.end(), 1, std::multiplies<>()), 0));
+    // a line ends at a newline or at the end of the file, a carriage return before the newline is ignored
+    auto lineEnd = [pEnd](const char *pLine) {
+        const auto *pNewline = static_cast<const char*>(std::memchr(pLine, '\n', pEnd - pLine));
+        return pNewline == nullptr ? pEnd : pNewline;
+    };
+    auto contentEnd = [](const char *pLine, const char *pNewline) {
+        return pNewline > pLine && pNewline[-1] == '\r' ? pNewline - 1 : pNewline;
+    };
+    auto skip = [pEnd](const char *pNewline) { return pNewline == pEnd ? pEnd : pNewline + 1; };
 
-        for (auto & i : tensor)
+    const char *pData = pBegin;
+    if (header && pData != pEnd)
+    {
+        pData = skip(lineEnd(pData));
+    }
+
+    // the first non-empty line determines the number of columns
+    size_t columns = 0;
+    for (const char *pLine = pData; pLine != pEnd && columns == 0; pLine = skip(lineEnd(pLine)))
+    {
+        const char *pContent = contentEnd(pLine, lineEnd(pLine));
+        if (pContent != pLine)
         {
-            if (file_iterator == file_end)
+            columns = std::count(pLine, pContent, delimiter) + 1;
+        }
+    }
+    if (columns == 0)
+    {
+        throw std::invalid_argument("CSV_READER::read_csv: " + path + " contains no rows");
+    }
+
+    // the position of every column in the sample or label row, -1 if it is not read
+    std::vector<std::int64_t> sampleSlot(columns, -1);
+    std::vector<std::int64_t> labelSlot(columns, -1);
+    auto assign = [&](const std::vector<size_t> &selection, std::vector<std::int64_t> &slots) {
+        for (size_t i = 0; i < selection.size(); i++)
+        {
+            if (selection[i] >= columns || slots[selection[i]] != -1)
             {
-                throw std::invalid_argument("IDX_READER::read_idx: Unexpected end of file");
+                throw std::invalid_argument("CSV_READER::read_csv: Column " + std::to_string(selection[i]) + " does not exist or is selected twice");
             }
-            for (Precision & j : i)
+            slots[selection[i]] = static_cast<std::int64_t>(i);
+        }
+    };
+    if (labelColumns.empty())
+    {
+        throw std::invalid_argument("CSV_READER::read_csv: At least one label column is needed");
+    }
+    assign(labelColumns, labelSlot);
+    if (featureColumns.empty())
+    {
+        std::vector<size_t> remaining;
+        for (size_t c = 0; c < columns; c++)
+        {
+            if (labelSlot[c] == -1)
             {
-                j = static_cast<double>(static_cast<std::byte>(*file_iterator++));
+                remaining.push_back(c);
             }
         }
+        assign(remaining, sampleSlot);
     }
     else
     {
-        throw std::invalid_argument("IDX_READER::read_idx: Unknown magic number");
+        assign(featureColumns, sampleSlot);
+    }
+    const size_t sampleWidth = std::ranges::count_if(sampleSlot, [](const std::int64_t slot) { return slot != -1; });
+    if (sampleWidth == 0)
+    {
+        throw std::invalid_argument("CSV_READER::read_csv: At least one feature column is needed");
     }
+    const size_t labelWidth = labelColumns.size();
 
-    return tensor;
-}
+    // chunks of about a megabyte that start after a newline
+    const size_t length = pEnd - pData;
+    const size_t chunkCount = std::max<size_t>(1, std::min<size_t>(length >> 20, Parallel::threadCount() * 8));
+    std::vector<const char*> bounds(chunkCount + 1, pEnd);
+    bounds[0] = pData;
+    for (size_t c = 1; c < chunkCount; c++)
+    {
+        const char *pGuess = std::max(pData + c * length / chunkCount, bounds[c - 1]);
+        bounds[c] = pGuess[-1] == '\n' ? pGuess : skip(lineEnd(pGuess));
+    }
 
-void Reader::read_bin(std::vector<std::vector<Precision>> const & designMatrix, std::vector<std::vector<Precision>> const & label, const std::string &path)
-{
-    throw std::invalid_argument("Under maintenance");
-    // typedef std::vector<std::vector<double>> data_type;
-    // std::ifstream file(std::filesystem::path(path), std::ios::binary);
-    //
-    // if (!file.is_open())
-    //     throw std::invalid_argument("BIN_READER::read_bin: Could not open file");
-    //
-    // // CIFAR-10 format: https://www.cs.toronto.edu/~kriz/cifar.html
-    //
-    // for (std::uint32_t i = 0; i < 10000; i++)
-    // {
-    //     std::byte read;
-    //     file.read(reinterpret_cast<char*>(&read), sizeof(read));
-    //
-    //     label.push_back(std::to_integer<double>(read));
-    //
-    //     designMatrix.push_back(std::vector<double>(3072));
-    //
-    //     for (std::uint32_t j = 0; j < 3072; j++)
-    //     {
-    //         std::byte pixel;
-    //         file.read(reinterpret_cast<char*>(&pixel), sizeof(pixel));
-    //         designMatrix[i][j] = std::to_integer<double>(pixel);
-    //     }
-    // }
-}
\ No newline at end of file
+    // count the rows of every chunk, so every chunk knows where its rows start
+    std::vector<size_t> firstRow(chunkCount + 1, 0);
+    Parallel::forEach(chunkCount, length, [&](const std::uint64_t c) {
+        size_t rows = 0;
+        for (const char *pLine = bounds[c]; pLine < bounds[c + 1]; pLine = skip(lineEnd(pLine)))
+        {
+            rows += contentEnd(pLine, lineEnd(pLine)) != pLine;
+        }
+        firstRow[c + 1] = rows;
+    });
+    std::partial_sum(firstRow.begin(), firstRow.end(), firstRow.begin());
+    const size_t rows = firstRow[chunkCount];
+
+    std::vector<Precision> sampleValues(rows * sampleWidth);
+    std::vector<Precision> labelValues(rows * labelWidth);
+    std::vector<std::exception_ptr> errors(chunkCount);
+    Parallel::forEach(chunkCount, 4 * length, [&](const std::uint64_t c) {
+        try
+        {
+            size_t row = firstRow[c];
+            for (const char *pLine = bounds[c]; pLine < bounds[c + 1]; pLine = skip(lineEnd(pLine)))
+            {
+                const char *pContent = contentEnd(pLine, lineEnd(pLine));
+                if (pContent == pLine)
+                {
+                    continue;
+                }
+                const char *pField = pLine;
+                for (size_t column = 0; column < columns; column++)
+                {
+                    if (pField > pContent)
+                    {
+                        throw std::invalid_argument("CSV_READER::read_csv: Row " + std::to_string(row) + " has too few columns");
+                    }
+                    const auto *pDelimiter = static_cast<const char*>(std::memchr(pField, delimiter, pContent - pField));
+                    const char *pFieldEnd = pDelimiter == nullptr ? pContent : pDelimiter;
+                    if (sampleSlot[column] != -1 || labelSlot[column] != -1)
+                    {
+                        const char *pNumber = pField;
+                        const char *pNumberEnd = pFieldEnd;
+                        while (pNumber < pNumberEnd && (*pNumber == ' ' || *pNumber == '\t'))
+                        {
+                            pNumber++;
+                        }
+                        while (pNumberEnd > pNumber && (pNumberEnd[-1] == ' ' || pNumberEnd[-1] == '\t'))
+                        {
+                            pNumberEnd--;
+                        }
+                        if (pNumber < pNumberEnd && *pNumber == '+') // from_chars only accepts a minus sign
+                        {
+                            pNumber++;
+                        }
+                        Precision value = 0;
+                        const auto [pParsed, error] = std::from_chars(pNumber, pNumberEnd, value);
+                        if (error != std::errc() || pParsed != pNumberEnd || pNumber == pNumberEnd)
+                        {
+                            throw std::invalid_argument("CSV_READER::read_csv: Could not parse \"" + std::string(pField, pFieldEnd) + "\" in row " + std::to_string(row));
+                        }
+                        if (sampleSlot[column] != -1)
+                        {
+                            sampleValues[row * sampleWidth + sampleSlot[column]] = value;
+                        }
+                        if (labelSlot[column] != -1)
+                        {
+                            labelValues[row * labelWidth + labelSlot[column]] = value;
+                        }
+                    }
+                    pField = pFieldEnd + 1;
+                }
+                if (pField <= pContent)
+                {
+                    throw std::invalid_argument("CSV_READER::read_csv: Row " + std::to_string(row) + " has too many columns");
+                }
+                row++;
+            }
+        }
+        catch (...)
+        {
+            errors[c] = std::current_exception(); // an exception must not leave a thread
+        }
+    });
+    for (const std::exception_ptr &error : errors)
+    {
+        if (error != nullptr)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+    samples = SampleStorage(std::move(sampleValues), sampleWidth);
+    labels = SampleStorage(std::move(labelValues), labelWidth);
+}
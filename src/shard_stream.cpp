@@ -0,0 +1,297 @@
+//
+// Created by servant-of-scietia on 18.10.26.
+//
+
+#include "shard_stream.hpp"
+#include "reader.hpp"
+
+#include <cstring>
+
+#if defined(__unix__)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+ShardStream::ShardStream(const std::vector<std::pair<std::string, std::string>> &shards, const std::uint64_t memoryBudget, const std::uint32_t readers) :
+mReaderCount(std::max(1u, readers))
+{
+    if (shards.empty())
+    {
+        throw std::invalid_argument("ShardStream::ShardStream: The stream needs at least one shard.");
+    }
+
+    std::vector<std::uint64_t> rows;
+    for (const auto &[samples, labels] : shards)
+    {
+        auto header = [](const std::string &path) {
+            const std::uint64_t size = std::filesystem::file_size(path);
+            std::vector<std::byte> bytes(std::min<std::uint64_t>(size, 4 + 4 * 255)); // the longest header
+            mRead(path, 0, bytes.size(), bytes.data());
+            Reader::idx_header header = Reader::read_idx_header(bytes.data(), bytes.size());
+            if (size - header.offset < header.shape[0] * header.width * SampleStorage::elementSize(header.type))
+            {
+                throw std::invalid_argument("ShardStream::ShardStream: Unexpected end of file " + path);
+            }
+            return header;
+        };
+        const Reader::idx_header sampleHeader = header(samples);
+        const Reader::idx_header labelHeader = header(labels);
+        if (sampleHeader.shape[0] != labelHeader.shape[0])
+        {
+            throw std::invalid_argument("ShardStream::ShardStream: The samples and labels of " + samples + " have different sizes.");
+        }
+        if (mShards.empty())
+        {
+            mSampleType = sampleHeader.type;
+            mLabelType = labelHeader.type;
+            mWidth = sampleHeader.width;
+            mLabelWidth = labelHeader.width;
+        }
+        else if (sampleHeader.type != mSampleType || labelHeader.type != mLabelType || sampleHeader.width != mWidth || labelHeader.width != mLabelWidth)
+        {
+            throw std::invalid_argument("ShardStream::ShardStream: The shard " + samples + " does not match the first shard.");
+        }
+        mShards.push_back({samples, labels, sampleHeader.offset, labelHeader.offset});
+        rows.push_back(sampleHeader.shape[0]);
+        mSize += sampleHeader.shape[0];
+    }
+    mSampleBytes = mWidth * SampleStorage::elementSize(mSampleType);
+    mLabelBytes = mLabelWidth * SampleStorage::elementSize(mLabelType);
+
+    // half of the budget for the shuffle buffer, the rest for reading ahead, every reader can hold two chunks
+    const std::uint64_t rowBytes = mSampleBytes + mLabelBytes;
+    mPoolRows = std::min(mSize, memoryBudget / 2 / rowBytes);
+    mReadBudget = memoryBudget - mPoolRows * rowBytes;
+    if (mPoolRows == 0 || mReadBudget < rowBytes)
+    {
+        throw std::invalid_argument("ShardStream::ShardStream: The memory budget does not hold two rows.");
+    }
+    const std::uint64_t chunkRows = std::max<std::uint64_t>(1, mReadBudget / (2 * mReaderCount) / rowBytes);
+    for (std::uint32_t s = 0; s < mShards.size(); s++)
+    {
+        for (std::uint64_t first = 0; first < rows[s]; first += chunkRows)
+        {
+            mChunks.push_back({s, first, std::min(chunkRows, rows[s] - first)});
+        }
+    }
+
+    mpPoolSamples = std::make_shared<std::vector<std::byte>>(mPoolRows * mSampleBytes);
+    mpPoolLabels = std::make_shared<std::vector<std::byte>>(mPoolRows * mLabelBytes);
+    mPoolSampleView = SampleStorage(mpPoolSamples, mpPoolSamples->data(), mSampleType, true, mPoolRows * mWidth, mWidth);
+    mPoolLabelView = SampleStorage(mpPoolLabels, mpPoolLabels->data(), mLabelType, true, mPoolRows * mLabelWidth, mLabelWidth);
+}
+
+ShardStream::~ShardStream()
+{
+    stop();
+}
+
+void ShardStream::mRead(const std::string &path, std::uint64_t offset, std::uint64_t bytes, std::byte *pDestination)
+{
+#if defined(__unix__)
+    const int descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0)
+    {
+        throw std::runtime_error("ShardStream::mRead: Could not open " + path);
+    }
+    while (bytes > 0)
+    {
+        const ssize_t read = pread(descriptor, pDestination, bytes, static_cast<off_t>(offset));
+        if (read < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (read <= 0)
+        {
+            close(descriptor);
+            throw std::runtime_error("ShardStream::mRead: Could not read " + path);
+        }
+        pDestination += read;
+        offset += read;
+        bytes -= read;
+    }
+    close(descriptor);
+#else
+    std::ifstream file(std::filesystem::path(path), std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(offset));
+    file.read(reinterpret_cast<char *>(pDestination), static_cast<std::streamsize>(bytes));
+    if (!file)
+    {
+        throw std::runtime_error("ShardStream::mRead: Could not read " + path);
+    }
+#endif
+}
+
+std::uint64_t ShardStream::mChunkBytes(const std::uint64_t position) const
+{
+    return mChunks[mOrder[position]].rows * (mSampleBytes + mLabelBytes);
+}
+
+void ShardStream::mReadAhead()
+{
+    std::unique_lock lock(mMutex);
+    while (true)
+    {
+        // the chunks are handed out in the order they are consumed, so the chunk the consumer waits for never waits for memory
+        mChanged.wait(lock, [&] { return mStop || mClaimed == mOrder.size() || mReserved + mChunkBytes(mClaimed) <= mReadBudget; });
+        if (mStop || mClaimed == mOrder.size())
+        {
+            return;
+        }
+        const std::uint64_t position = mClaimed++;
+        mReserved += mChunkBytes(position);
+        lock.unlock();
+
+        const Chunk &chunk = mChunks[mOrder[position]];
+        const Shard &shard = mShards[chunk.shard];
+        std::vector<std::byte> samples(chunk.rows * mSampleBytes);
+        std::vector<std::byte> labels(chunk.rows * mLabelBytes);
+        try
+        {
+            mRead(shard.samples, shard.samplesOffset + chunk.first * mSampleBytes, samples.size(), samples.data());
+            mRead(shard.labels, shard.labelsOffset + chunk.first * mLabelBytes, labels.size(), labels.data());
+        }
+        catch (...)
+        {
+            lock.lock();
+            mpError = std::current_exception();
+            mChanged.notify_all();
+            return;
+        }
+
+        lock.lock();
+        mSamples[position] = std::move(samples);
+        mLabels[position] = std::move(labels);
+        mLoaded[position] = true;
+        mBytesRead.fetch_add(mChunkBytes(position), std::memory_order_relaxed);
+        mChanged.notify_all();
+    }
+}
+
+void ShardStream::start()
+{
+    stop();
+    mOrder.resize(mChunks.size());
+    std::iota(mOrder.begin(), mOrder.end(), 0);
+    std::ranges::shuffle(mOrder, mGenerator);
+    mSamples.assign(mOrder.size(), {});
+    mLabels.assign(mOrder.size(), {});
+    mLoaded.assign(mOrder.size(), false);
+    mClaimed = 0;
+    mReserved = 0;
+    mStop = false;
+    mpError = nullptr;
+    mCurrent = 0;
+    mCurrentRow = 0;
+    mPosition = 0;
+    mPoolFill = 0;
+    for (std::uint32_t r = 0; r < mReaderCount; r++)
+    {
+        mReaders.emplace_back(&ShardStream::mReadAhead, this);
+    }
+    mRunning = true;
+}
+
+void ShardStream::stop()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mStop = true;
+    }
+    mChanged.notify_all();
+    for (std::thread &reader : mReaders)
+    {
+        reader.join();
+    }
+    mReaders.clear();
+    mRunning = false;
+}
+
+void ShardStream::mFill()
+{
+    while (mPoolFill < mPoolRows && mCurrent < mOrder.size())
+    {
+        {
+            std::unique_lock lock(mMutex);
+            mChanged.wait(lock, [&] { return mLoaded[mCurrent] || mpError != nullptr; });
+            if (mpError != nullptr)
+            {
+                std::rethrow_exception(mpError);
+            }
+        }
+        const std::uint64_t rows = std::min(mPoolRows - mPoolFill, mChunks[mOrder[mCurrent]].rows - mCurrentRow);
+        std::memcpy(mpPoolSamples->data() + mPoolFill * mSampleBytes, mSamples[mCurrent].data() + mCurrentRow * mSampleBytes, rows * mSampleBytes);
+        std::memcpy(mpPoolLabels->data() + mPoolFill * mLabelBytes, mLabels[mCurrent].data() + mCurrentRow * mLabelBytes, rows * mLabelBytes);
+        mPoolFill += rows;
+        mCurrentRow += rows;
+
+        if (mCurrentRow == mChunks[mOrder[mCurrent]].rows) // release the chunk for the readers
+        {
+            std::lock_guard lock(mMutex);
+            mSamples[mCurrent] = {};
+            mLabels[mCurrent] = {};
+            mReserved -= mChunkBytes(mCurrent);
+            mCurrent++;
+            mCurrentRow = 0;
+            mChanged.notify_all();
+        }
+    }
+}
+
+void ShardStream::next(const std::uint32_t batchSize, std::shared_ptr<Tensor> &data, std::shared_ptr<Tensor> &labels)
+{
+    if (!mRunning)
+    {
+        throw std::logic_error("ShardStream::next: The epoch has not been started.");
+    }
+    if (mPosition + batchSize > mSize)
+    {
+        throw std::invalid_argument("ShardStream::next: The batch size is larger than the remaining size of the epoch.");
+    }
+    auto prepare = [batchSize](std::shared_ptr<Tensor> &batch, const std::uint64_t width) {
+        const std::vector<size_t> shape = {batchSize, width};
+        if (batch == nullptr || batch.use_count() > 1 || batch->shape() != shape) // tensors nobody else holds are overwritten
+        {
+            batch = std::make_shared<Tensor>(Tensor(shape, 0));
+        }
+    };
+    prepare(data, mWidth);
+    prepare(labels, mLabelWidth);
+
+    for (std::uint32_t i = 0; i < batchSize; i++)
+    {
+        mFill();
+        const std::uint64_t slot = std::uniform_int_distribution<std::uint64_t>(0, mPoolFill - 1)(mGenerator);
+        mPoolSampleView.copyRow(slot, data->data() + i * mWidth);
+        mPoolLabelView.copyRow(slot, labels->data() + i * mLabelWidth);
+
+        mPoolFill--;
+        if (slot != mPoolFill) // the last row of the buffer takes the free slot
+        {
+            std::memcpy(mpPoolSamples->data() + slot * mSampleBytes, mpPoolSamples->data() + mPoolFill * mSampleBytes, mSampleBytes);
+            std::memcpy(mpPoolLabels->data() + slot * mLabelBytes, mpPoolLabels->data() + mPoolFill * mLabelBytes, mLabelBytes);
+        }
+        mPosition++;
+    }
+}
+
+void ShardStream::setTransformation(const std::vector<Precision> &scale, const std::vector<Precision> &offset)
+{
+    mPoolSampleView.setTransformation(scale, offset);
+}
+
+std::uint64_t ShardStream::size() const
+{
+    return mSize;
+}
+
+std::uint64_t ShardStream::position() const
+{
+    return mPosition;
+}
+
+std::uint64_t ShardStream::bytesRead() const
+{
+    return mBytesRead.load(std::memory_order_relaxed);
+}
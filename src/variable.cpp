@@ -53,6 +53,17 @@ std::shared_ptr<Tensor> &Variable::getData()
 void Variable::setData(const std::shared_ptr<Tensor> &data)
 {
     mpDataTensor = data;
+    mVersion++;
+}
+
+std::uint64_t Variable::getVersion() const
+{
+    return mVersion;
+}
+
+void Variable::bumpVersion()
+{
+    mVersion++;
 }
 
 std::uint32_t Variable::getId() const
@@ -0,0 +1,77 @@
+#include "synthetic.hpp"
+
+// Scaling benchmark of synchronous data parallel training: the same model is trained on the same synthetic data with
+// 1, 2, 4, ... replicas up to the number of cores (or the first argument), the throughput and the speedup against one
+// replica are printed for every replica count.
+
+namespace
+{
+    constexpr std::uint32_t msFeatures = 256;
+    constexpr std::uint32_t msClasses = 10;
+    constexpr std::uint32_t msExamples = 8192;
+    constexpr std::uint32_t msBatchSize = 256;
+    constexpr std::uint32_t msEpochs = 2;
+
+    /**
+     * @brief train a fixed model with the given number of replicas and return the examples per second
+     */
+    double throughput(const std::uint32_t replicas, const Synthetic::dataType &trainingData, const Synthetic::dataType &trainingLabels, const Synthetic::dataType &testData, const Synthetic::dataType &testLabels)
+    {
+        Random::setSeed(1234);
+        Dataset dataset(trainingData, trainingLabels, testData, testLabels, "synthetic");
+
+        Model model;
+        model.addSequential({
+            Dense(ReLU(), 512, "dense0"),
+            Dense(ReLU(), 512, "dense1"),
+            Dense(Softmax(), msClasses, "output"),
+            Loss(ErrorRate(), "loss")
+        });
+        model.setDataParallel(replicas);
+
+        const auto start = std::chrono::steady_clock::now();
+        model.train(dataset, "dense0", "loss", msEpochs, msBatchSize, Adam(0.001), msEpochs);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return static_cast<double>(msEpochs) * (msExamples / msBatchSize) * msBatchSize / seconds;
+    }
+}
+
+std::int32_t main(const std::int32_t argc, char **argv)
+{
+    const std::uint32_t maximum = argc > 1 ? static_cast<std::uint32_t>(std::stoul(argv[1])) : std::max(1u, std::thread::hardware_concurrency());
+
+    Synthetic::dataType trainingData, trainingLabels, testData, testLabels;
+    Synthetic::makeData(msExamples, msFeatures, msClasses, trainingData, trainingLabels);
+    Synthetic::makeData(msBatchSize, msFeatures, msClasses, testData, testLabels);
+
+    std::vector<std::uint32_t> replicaCounts;
+    for (std::uint32_t replicas = 1; replicas <= maximum; replicas *= 2)
+    {
+        replicaCounts.push_back(replicas);
+    }
+    if (replicaCounts.back() != maximum)
+    {
+        replicaCounts.push_back(maximum);
+    }
+
+    std::vector<double> results;
+    for (const std::uint32_t replicas : replicaCounts)
+    {
+        results.push_back(throughput(replicas, trainingData, trainingLabels, testData, testLabels));
+    }
+
+    std::cout << "[\n";
+    for (size_t i = 0; i < replicaCounts.size(); i++)
+    {
+        const double speedup = results[i] / results[0];
+        std::cout << " \t{\n";
+        std::cout << " \t \t \"data_parallel_replicas\": " << replicaCounts[i] << ",\n";
+        std::cout << " \t \t \"examples_per_second\": " << results[i] << ",\n";
+        std::cout << " \t \t \"speedup\": " << speedup << ",\n";
+        std::cout << " \t \t \"scaling_efficiency\": " << speedup / replicaCounts[i] << "\n";
+        std::cout << " \t}" << (i + 1 < replicaCounts.size() ? "," : "") << "\n";
+    }
+    std::cout << "]" << std::endl;
+
+    return 0;
+}
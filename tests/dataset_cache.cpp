@@ -0,0 +1,100 @@
+#include "brainet.hpp"
+
+// Test of DatasetCache: a second load of the same IDX files must map the existing cache file instead of writing a new one,
+// also without a seed, where every run draws another split. In deterministic mode the seed selects the file, and a
+// changed input creates a new file.
+
+namespace
+{
+    /**
+     * @brief write an IDX file of bytes
+     */
+    void writeIdx(const std::filesystem::path &path, const std::vector<std::uint32_t> &shape)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.put(0).put(0).put(0x08).put(static_cast<char>(shape.size()));
+        std::uint64_t count = 1;
+        for (const std::uint32_t dimension : shape)
+        {
+            for (std::int32_t shift = 24; shift >= 0; shift -= 8)
+            {
+                file.put(static_cast<char>(dimension >> shift));
+            }
+            count *= dimension;
+        }
+        for (std::uint64_t i = 0; i < count; i++)
+        {
+            file.put(static_cast<char>(i * 7 % 251));
+        }
+    }
+
+    /**
+     * @brief get the number of cache files in the directory
+     */
+    size_t countFiles(const std::filesystem::path &directory)
+    {
+        return std::ranges::count_if(std::filesystem::directory_iterator(directory), [](const std::filesystem::directory_entry &entry) {
+            return entry.path().extension() == ".dataset";
+        });
+    }
+
+    /**
+     * @brief get the sum of the samples of the training set, independent of the order
+     */
+    double trainingSum(Dataset &dataset)
+    {
+        dataset.shuffleTrainingSet();
+        std::shared_ptr<Tensor> data;
+        std::shared_ptr<Tensor> labels;
+        dataset.gatherTrainingBatch(0, dataset.trainingSetSize(), data, labels);
+        return std::accumulate(data->data(), data->data() + data->capacity(), 0.0);
+    }
+}
+
+std::int32_t main()
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "brainet_dataset_cache_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    writeIdx(directory / "train-data", {100, 6});
+    writeIdx(directory / "train-labels", {100});
+    writeIdx(directory / "test-data", {10, 6});
+    writeIdx(directory / "test-labels", {10});
+
+    const DatasetCache cache((directory / "cache").string());
+    auto load = [&]() {
+        return cache.loadIdx((directory / "train-data").string(), (directory / "train-labels").string(),
+                             (directory / "test-data").string(), (directory / "test-labels").string(), 0.8, true);
+    };
+
+    std::int32_t failures = 0;
+    auto check = [&failures](const std::string &name, const bool passed) {
+        std::cout << (passed ? "passed: " : "FAILED: ") << name << std::endl;
+        failures += passed ? 0 : 1;
+    };
+
+    Random::setDeterministic(false);
+    Dataset first = load();
+    const std::filesystem::path file = std::filesystem::directory_iterator(directory / "cache")->path();
+    const std::filesystem::file_time_type written = std::filesystem::last_write_time(file);
+    Dataset second = load();
+    check("an unseeded load maps the existing file", countFiles(directory / "cache") == 1 && std::filesystem::last_write_time(file) == written);
+    check("the mapped file holds the same split", first.trainingSetSize() == 80 && second.trainingSetSize() == 80 && trainingSum(first) == trainingSum(second));
+
+    Random::setSeed(1);
+    Dataset seeded = load();
+    Random::setSeed(1);
+    Dataset again = load();
+    check("a seed selects its own file", countFiles(directory / "cache") == 2 && trainingSum(seeded) == trainingSum(again));
+    Random::setSeed(2);
+    Dataset other = load();
+    check("another seed creates another file", countFiles(directory / "cache") == 3);
+
+    std::filesystem::last_write_time(directory / "train-labels", std::filesystem::last_write_time(directory / "train-labels") + std::chrono::seconds(5));
+    Random::setSeed(2);
+    Dataset changed = load();
+    check("a changed input creates another file", countFiles(directory / "cache") == 4);
+
+    std::filesystem::remove_all(directory);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+#include "synthetic.hpp"
+
+#include <cstring>
+
+// Regression test of the deterministic mode: two seeded runs must produce bitwise identical weights,
+// also when the kernels and the replicas of data parallel training run on several threads. The shapes are chosen so that
+// every product has several times the work a kernel thread gets at least, otherwise all kernels would run on one thread.
+
+namespace
+{
+    // large enough that the products, reductions and softmax are split over several threads
+    constexpr std::uint32_t msFeatures = 128;
+    constexpr std::uint32_t msHidden = 256;
+    constexpr std::uint32_t msClasses = 4;
+    constexpr std::uint32_t msBatchSize = 256;
+
+    /**
+     * @brief build and train a small model from the seed and return copies of its parameters
+     */
+    std::vector<Tensor> train(const std::uint32_t threads, const std::uint32_t replicas, const double dropout)
+    {
+        Random::setSeed(1234);
+        Parallel::setThreadCount(threads);
+
+        Synthetic::dataType trainingData, trainingLabels, testData, testLabels;
+        Synthetic::makeData(4 * msBatchSize, msFeatures, msClasses, trainingData, trainingLabels);
+        Synthetic::makeData(msBatchSize, msFeatures, msClasses, testData, testLabels);
+        Dataset dataset(trainingData, trainingLabels, testData, testLabels, "synthetic");
+
+        Model model;
+        const std::vector<std::shared_ptr<Module>> modules = {
+            model.addModule(Dense(ReLU(), msHidden, "dense0", dropout)),
+            model.addModule(Dense(Softmax(), msClasses, "output")),
+            model.addModule(Loss(ErrorRate(), "loss"))
+        };
+        Model::connectModules(modules[0], modules[1]);
+        Model::connectModules(modules[1], modules[2]);
+        model.setDataParallel(replicas);
+        model.train(dataset, "dense0", "loss", 3, msBatchSize, Adam(0.01), 3);
+
+        std::vector<Tensor> parameters;
+        for (const std::shared_ptr<Module> &module : modules)
+        {
+            for (const std::shared_ptr<Variable> &variable : module->getLearnableVariables())
+            {
+                parameters.push_back(*variable->getData());
+            }
+        }
+        Parallel::setThreadCount(0);
+        return parameters;
+    }
+
+    bool identical(std::vector<Tensor> &first, std::vector<Tensor> &second)
+    {
+        if (first.size() != second.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < first.size(); i++)
+        {
+            if (first[i].shape() != second[i].shape() ||
+                std::memcmp(first[i].data(), second[i].data(), first[i].capacity() * sizeof(Precision)) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+std::int32_t main()
+{
+    // the smallest product of a data parallel replica, a smaller one would run on one thread and the test would be vacuous
+    const std::uint64_t work = static_cast<std::uint64_t>(msBatchSize / 2) * (msHidden + 1) * msClasses;
+    if (work <= 4 * Parallel::msMinimumWork)
+    {
+        std::cout << "FAILED: the products are too small to be split over four threads" << std::endl;
+        return 1;
+    }
+
+    std::int32_t failures = 0;
+    auto check = [&failures](const std::string &name, std::vector<Tensor> first, std::vector<Tensor> second) {
+        const bool passed = identical(first, second);
+        std::cout << (passed ? "passed: " : "FAILED: ") << name << std::endl;
+        failures += passed ? 0 : 1;
+    };
+
+    check("two sequential runs", train(1, 1, 0.8), train(1, 1, 0.8));
+    check("one and four kernel threads", train(1, 1, 0.8), train(4, 1, 0.8));
+    check("two data parallel runs", train(4, 2, 1.0), train(4, 2, 1.0));
+
+    return failures == 0 ? 0 : 1;
+}
@@ -2,17 +2,6 @@
 
 std::int32_t main()
 {
-    typedef std::vector<std::vector<Precision>> dataType;
-
-    dataType train_input = Reader::read_idx("../data/mnist/train-images.idx3-ubyte");
-    dataType train_target = Reader::read_idx("../data/mnist/train-labels.idx1-ubyte");
-
-    dataType test_input = Reader::read_idx("../data/mnist/t10k-images.idx3-ubyte");
-    dataType test_target = Reader::read_idx("../data/mnist/t10k-labels.idx1-ubyte");
-
-    train_input = Preprocessing::normalize(train_input);
-    test_input = Preprocessing::normalize(test_input);
-
     Model model;
 
     model.addSequential({
@@ -21,7 +10,9 @@ std::int32_t main()
         Loss(ErrorRate(), "loss")
     });
 
-    Dataset dataset(train_input, train_target, 0.8, test_input, test_target);
+    // the split and normalized dataset is cached, later runs map it instead of preparing it again
+    Dataset dataset = DatasetCache("../data/cache").loadIdx("../data/mnist/train-images.idx3-ubyte", "../data/mnist/train-labels.idx1-ubyte",
+        "../data/mnist/t10k-images.idx3-ubyte", "../data/mnist/t10k-labels.idx1-ubyte", 0.8, true);
 
     model.train(dataset, "dense0", "loss", 100, 128, Adam(0.001), 10);
     model.test( dataset, "dense0", "loss");
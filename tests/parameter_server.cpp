@@ -0,0 +1,122 @@
+#include "synthetic.hpp"
+
+#include <cstring>
+
+// Test of the worker/server protocol of ParameterServer on this machine: every batch must be trained exactly once, the
+// weights must change, and the staleness must stay within its bound. With a bound of 0 the workers advance in lockstep,
+// so every round of k <= W updates is computed with the same weights and the updates miss 0, 1, ..., k - 1 others.
+// A gradient can miss at most (W - 1) * (2 * staleness + 1) updates. Graphs with sharded layers must be rejected.
+
+namespace
+{
+    constexpr std::uint32_t msBatchSize = 16;
+    constexpr std::uint32_t msExamples = 24 * msBatchSize;
+
+    /**
+     * @brief train one epoch with worker processes
+     * @param shards the shards of the hidden layer, more than one must be rejected
+     * @return true if all checks passed
+     */
+    bool run(const std::uint32_t workers, const std::uint32_t staleness, const std::uint32_t shards = 1)
+    {
+        Random::setSeed(1234);
+        Synthetic::dataType trainingData, trainingLabels, testData, testLabels;
+        Synthetic::makeData(msExamples, 8, 4, trainingData, trainingLabels);
+        Synthetic::makeData(msBatchSize, 8, 4, testData, testLabels);
+        Dataset dataset(trainingData, trainingLabels, testData, testLabels, "synthetic");
+
+        // the graph of a model, connected to the dataset like Model::train does
+        Model model;
+        const std::shared_ptr<Module> pHidden = model.addModule(Dense(ReLU(), 16, "hidden", 1.0, shards));
+        const std::shared_ptr<Module> pOutput = model.addModule(Dense(Softmax(), 4, "output"));
+        const std::shared_ptr<Module> pLoss = model.addModule(Loss(ErrorRate(), "loss"));
+        Model::connectModules(pHidden, pOutput);
+        Model::connectModules(pOutput, pLoss);
+        Variable::connectVariables(dataset.getOutputs()[0], pHidden->getInputs()[0]);
+        Variable::connectVariables(dataset.getOutputs()[1], pLoss->getInputs()[0]);
+        Variable::connectVariables(dataset.getOutputs()[1], pLoss->getInputs()[1]);
+
+        std::vector<std::shared_ptr<Variable>> learnables, leaves;
+        for (const std::shared_ptr<Module> &pModule : {pHidden, pOutput, pLoss})
+        {
+            const std::vector<std::shared_ptr<Variable>> moduleLearnables = pModule->getLearnableVariables();
+            const std::vector<std::shared_ptr<Variable>> moduleLeaves = pModule->getGradientVariables();
+            learnables.insert(learnables.end(), moduleLearnables.begin(), moduleLearnables.end());
+            leaves.insert(leaves.end(), moduleLeaves.begin(), moduleLeaves.end());
+        }
+        const std::vector<std::shared_ptr<Variable>> losses = pLoss->getOutputs();
+        std::vector<std::shared_ptr<Variable>> graphInputs = dataset.getOutputs();
+        graphInputs.insert(graphInputs.end(), learnables.begin(), learnables.end());
+
+        dataset.shuffleTrainingSet();
+        dataset.gatherTrainingBatch(0, msBatchSize, graphInputs[0]->getData(), graphInputs[1]->getData());
+        GRAPH->forward(graphInputs); // create the weights
+        std::vector<Tensor> initial;
+        for (const std::shared_ptr<Variable> &pVar : learnables)
+        {
+            initial.push_back(*pVar->getData());
+        }
+
+        ParameterServer server(workers, staleness);
+        OptimizerVariant optimizer = SGD(0.1, 1000u);
+        if (shards > 1)
+        {
+            bool rejected = false;
+            try
+            {
+                server.epoch(dataset, msBatchSize, graphInputs, learnables, leaves, losses, optimizer);
+            }
+            catch (const std::invalid_argument &)
+            {
+                rejected = true;
+            }
+            std::cout << (rejected ? "passed: " : "FAILED: ") << "sharded layers are rejected" << std::endl;
+            return rejected;
+        }
+        const std::vector<std::vector<double>> batchLosses = server.epoch(dataset, msBatchSize, graphInputs, learnables, leaves, losses, optimizer);
+
+        const std::uint32_t batches = dataset.trainingBatchCount(msBatchSize);
+        bool passed = batches > 0 && batchLosses.size() == batches;
+        for (const std::vector<double> &batch : batchLosses)
+        {
+            passed = passed && batch.size() == 2 && batch[1] > 0; // every batch was trained and reported
+        }
+        bool changed = false;
+        for (size_t k = 0; k < learnables.size(); k++)
+        {
+            changed = changed || std::memcmp(initial[k].data(), learnables[k]->getData()->data(), initial[k].capacity() * sizeof(Precision)) != 0;
+        }
+        passed = passed && changed;
+
+        const double meanStaleness = server.meanStaleness();
+        if (staleness == 0)
+        {
+            double missed = 0;
+            for (std::uint32_t first = 0; first < batches; first += workers) // the rounds
+            {
+                const std::uint32_t round = std::min(workers, batches - first);
+                missed += round * (round - 1) / 2.0;
+            }
+            passed = passed && meanStaleness == missed / batches;
+        }
+        else
+        {
+            passed = passed && meanStaleness <= static_cast<double>((workers - 1) * (2 * staleness + 1));
+        }
+
+        std::cout << (passed ? "passed: " : "FAILED: ") << workers << " workers, staleness " << staleness
+                  << ", mean staleness " << meanStaleness << std::endl;
+        return passed;
+    }
+}
+
+std::int32_t main()
+{
+    std::int32_t failures = 0;
+    for (const auto &[workers, staleness] : std::vector<std::pair<std::uint32_t, std::uint32_t>>{{1, 0}, {3, 0}, {4, 0}, {3, 2}})
+    {
+        failures += run(workers, staleness) ? 0 : 1;
+    }
+    failures += run(2, 0, 2) ? 0 : 1;
+    return failures == 0 ? 0 : 1;
+}
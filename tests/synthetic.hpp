@@ -0,0 +1,36 @@
+#ifndef SYNTHETIC_HPP
+#define SYNTHETIC_HPP
+
+#include "brainet.hpp"
+
+namespace Synthetic
+{
+    typedef std::vector<std::vector<Precision>> dataType;
+
+    /**
+     * @brief fill a synthetic classification problem with uniform features, the class of a sample is the one of the first
+     * classes features with the largest value
+     * @param size the number of samples
+     * @param width the number of features
+     * @param classes the number of classes, at most width
+     * @param data the samples
+     * @param labels the class of every sample
+     */
+    inline void makeData(const std::uint32_t size, const std::uint32_t width, const std::uint32_t classes, dataType &data, dataType &labels)
+    {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(0, 1);
+        data.assign(size, std::vector<Precision>(width));
+        labels.assign(size, std::vector<Precision>(1));
+        for (std::uint32_t i = 0; i < size; i++)
+        {
+            for (Precision &value : data[i])
+            {
+                value = static_cast<Precision>(distribution(generator));
+            }
+            labels[i][0] = static_cast<Precision>(std::distance(data[i].begin(), std::max_element(data[i].begin(), data[i].begin() + classes)));
+        }
+    }
+}
+
+#endif // SYNTHETIC_HPP